@@ -0,0 +1,173 @@
+/**
+ * DSMIL Convergence Benchmark - How many queries until a fresh table is fast
+ *
+ * From a cold anchor table, issues queries and records latency, anchor count
+ * and window size in log-scaled buckets of queries issued (1, 2, 4, ...), for
+ * each workload wrapper on each DSMIL data shape. Seeded and built tables and
+ * a RadixSpline show where a prepared model starts instead.
+ *
+ * Output is CSV, one row per (workload, dataset, model, bucket).
+ *
+ * Usage: convergence_benchmark [keys] [csv-file]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/not_stisla.h"
+#include "dsmil_datasets.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <assert.h>
+
+#define CONVERGE_DEFAULT_KEYS 1000000
+#define CONVERGE_BUCKETS 18                              /* Last bucket ends at 2^18 - 1 queries */
+#define CONVERGE_QUERIES ((size_t)(1u << CONVERGE_BUCKETS) - 1)
+#define CONVERGE_TRIALS 3                                /* Query orders averaged per bucket */
+#define CONVERGE_SPLINE_ERROR 32
+
+static inline uint64_t ns_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+typedef not_stisla_result_t (*wrapper_fn)(const int64_t*, size_t, int64_t, not_stisla_anchor_table_t*);
+
+/* Tolerances as the wrappers pass them, for seeding and building */
+static const struct {
+    const char* name;
+    wrapper_fn fn;
+    size_t tol;
+} workloads[] = {
+    { "telemetry", not_stisla_search_telemetry, 12 },
+    { "ids", not_stisla_search_ids, 6 },
+    { "offsets", not_stisla_search_offsets, 16 },
+    { "events", not_stisla_search_events, 10 },
+};
+
+enum { MODEL_COLD, MODEL_SEEDED, MODEL_BUILT, MODEL_SPLINE, MODEL_COUNT };
+static const char* const model_names[MODEL_COUNT] = { "cold", "seeded", "built", "radixspline" };
+
+/* Per-bucket sums over trials */
+typedef struct {
+    uint64_t ns;
+    size_t anchors;
+    size_t lookups;
+    size_t window_keys;
+    size_t escalations;
+} bucket_t;
+
+static inline size_t bucket_begin(int b) {
+    return ((size_t)1 << b) - 1;
+}
+
+/* The spline ignores the wrapper, so it is run once per dataset */
+static const char* series_workload_name(size_t w, int model) {
+    return model == MODEL_SPLINE ? "none" : workloads[w].name;
+}
+
+static void run_series(FILE* csv, size_t w, dsmil_data_kind_t kind, int model, const int64_t* arr, size_t n,
+                       int64_t* queries) {
+    bucket_t buckets[CONVERGE_BUCKETS] = { { 0 } };
+
+    for (int trial = 0; trial < CONVERGE_TRIALS; ++trial) {
+        dsmil_sample_queries(arr, n, queries, CONVERGE_QUERIES, 0.0, 1000 + (uint64_t)trial);
+
+        not_stisla_anchor_table_t* t = NULL;
+        not_stisla_spline_t* spline = NULL;
+        if (model == MODEL_SPLINE) {
+            spline = not_stisla_spline_build(arr, n, CONVERGE_SPLINE_ERROR, 0);
+            assert(spline && "Failed to build spline");
+        } else {
+            t = not_stisla_anchor_table_create();
+            assert(t && "Failed to create anchor table");
+            not_stisla_init_for_dsmil(t, (int)w);
+            if (model == MODEL_SEEDED) not_stisla_anchor_table_seed(t, arr, n, 0, workloads[w].tol);
+            if (model == MODEL_BUILT) not_stisla_anchor_table_build(t, arr, n, 0, workloads[w].tol);
+        }
+
+        for (int b = 0; b < CONVERGE_BUCKETS; ++b) {
+            const size_t begin = bucket_begin(b);
+            const size_t end = bucket_begin(b + 1);
+            not_stisla_search_stats_t before = { 0 }, after = { 0 };
+            if (t) not_stisla_get_search_stats(t, &before);
+
+            const uint64_t start = ns_now();
+            if (t) {
+                for (size_t q = begin; q < end; ++q) workloads[w].fn(arr, n, queries[q], t);
+            } else {
+                for (size_t q = begin; q < end; ++q) not_stisla_spline_search(spline, arr, queries[q]);
+            }
+            buckets[b].ns += ns_now() - start;
+
+            size_t anchors = 0;
+            if (t) {
+                not_stisla_get_search_stats(t, &after);
+                not_stisla_get_stats(t, NULL, &anchors, NULL);
+                buckets[b].lookups += after.lookups - before.lookups;
+                buckets[b].window_keys += after.window_keys - before.window_keys;
+                buckets[b].escalations += after.escalations - before.escalations;
+            } else {
+                size_t max_error = 0;
+                not_stisla_spline_get_stats(spline, &anchors, NULL, &max_error);
+                buckets[b].lookups += end - begin;
+                buckets[b].window_keys += (end - begin) * (2 * max_error + 1);
+            }
+            buckets[b].anchors += anchors;
+        }
+
+        not_stisla_anchor_table_destroy(t);
+        not_stisla_spline_destroy(spline);
+    }
+
+    for (int b = 0; b < CONVERGE_BUCKETS; ++b) {
+        const size_t size = bucket_begin(b + 1) - bucket_begin(b);
+        fprintf(csv, "%s,%s,%s,%zu,%zu,%.1f,%.1f,%.1f,%.4f\n", series_workload_name(w, model),
+                dsmil_data_name(kind), model_names[model], bucket_begin(b), bucket_begin(b + 1),
+                (double)buckets[b].ns / (double)(size * CONVERGE_TRIALS),
+                (double)buckets[b].anchors / CONVERGE_TRIALS,
+                buckets[b].lookups ? (double)buckets[b].window_keys / (double)buckets[b].lookups : 0.0,
+                (double)buckets[b].escalations / (double)(size * CONVERGE_TRIALS));
+    }
+    fflush(csv);
+}
+
+int main(int argc, char** argv) {
+    const size_t n = (argc > 1) ? strtoull(argv[1], NULL, 10) : CONVERGE_DEFAULT_KEYS;
+    if (n < 2) {
+        fprintf(stderr, "usage: %s [keys >= 2] [csv-file]\n", argv[0]);
+        return 2;
+    }
+    FILE* csv = (argc > 2) ? fopen(argv[2], "w") : stdout;
+    if (!csv) {
+        perror(argv[2]);
+        return 1;
+    }
+
+    int64_t* arr = malloc(n * sizeof(int64_t));
+    int64_t* queries = malloc(CONVERGE_QUERIES * sizeof(int64_t));
+    assert(arr && queries && "Failed to allocate memory");
+
+    /* Queries [first_query, end_query) of each trial; ns_per_op and
+     * escalation_rate are per query, anchors is the count after the bucket */
+    fprintf(csv, "workload,dataset,model,first_query,end_query,ns_per_op,anchors,mean_window,escalation_rate\n");
+    for (int kind = 0; kind < DSMIL_DATA_COUNT; ++kind) {
+        const dsmil_data_config_t cfg = { .n = n, .seed = 42, .skew = 1.0 };
+        dsmil_generate((dsmil_data_kind_t)kind, &cfg, arr);
+
+        for (size_t w = 0; w < sizeof(workloads) / sizeof(workloads[0]); ++w) {
+            fprintf(stderr, "%s data, %s wrapper\n", dsmil_data_name((dsmil_data_kind_t)kind), workloads[w].name);
+            for (int model = 0; model < MODEL_COUNT; ++model) {
+                if (model == MODEL_SPLINE && w > 0) continue;
+                run_series(csv, w, (dsmil_data_kind_t)kind, model, arr, n, queries);
+            }
+        }
+    }
+
+    if (csv != stdout) fclose(csv);
+    free(queries);
+    free(arr);
+    return 0;
+}
@@ -4,7 +4,10 @@
  * Simple performance verification for NOT_STISLA
  */
 
+#define _DEFAULT_SOURCE
+
 #include "../include/not_stisla.h"
+#include "perf_counters.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
@@ -12,6 +15,7 @@
 #include <sys/time.h>
 #include <string.h>
 #include <assert.h>
+#include <math.h>
 
 /* Timing utilities */
 static inline uint64_t ns_now(void) {
@@ -43,6 +47,220 @@ static void generate_test_data(int64_t* arr, size_t n) {
     }
 }
 
+/* Generate exponentially growing segment offsets */
+static void generate_offsets_data(int64_t* arr, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        arr[i] = (int64_t)(exp((double)i / (double)(n / 20)) * 1000.0) + (int64_t)i;
+    }
+}
+
+/* Compare interpolation modes on the offsets workload */
+static void benchmark_offsets_interpolation(size_t num_queries) {
+    const size_t n = 1000000;
+    int64_t* offsets = malloc(n * sizeof(int64_t));
+    int64_t* keys = malloc(num_queries * sizeof(int64_t));
+    assert(offsets && keys && "Failed to allocate memory");
+    generate_offsets_data(offsets, n);
+
+    srand(7);
+    for (size_t i = 0; i < num_queries; ++i) {
+        keys[i] = offsets[(size_t)rand() % n];
+    }
+
+    /* transform < 0 picks the transform from the data; fit passes the data
+     * to not_stisla_set_transform() so log/sqrt fit their shift */
+    static const struct {
+        const char* name;
+        not_stisla_interp_mode_t mode;
+        int transform;
+        bool fit;
+    } configs[] = {
+        { "linear", NOT_STISLA_INTERP_LINEAR, NOT_STISLA_TRANSFORM_NONE, false },
+        { "three-point", NOT_STISLA_INTERP_THREE_POINT, NOT_STISLA_TRANSFORM_NONE, false },
+        { "auto", NOT_STISLA_INTERP_AUTO, NOT_STISLA_TRANSFORM_NONE, false },
+        { "log", NOT_STISLA_INTERP_LINEAR, NOT_STISLA_TRANSFORM_LOG, false },
+        { "log fitted", NOT_STISLA_INTERP_LINEAR, NOT_STISLA_TRANSFORM_LOG, true },
+        { "fitted", NOT_STISLA_INTERP_LINEAR, -1, true },
+    };
+    double log_window = 0.0, log_fitted_window = 0.0;
+
+    printf("\n📐 Offsets Interpolation (learned, %zu queries):\n", num_queries);
+    for (size_t c = 0; c < sizeof(configs) / sizeof(configs[0]); ++c) {
+        not_stisla_anchor_table_t* t = not_stisla_anchor_table_create();
+        assert(t && "Failed to create anchor table");
+        not_stisla_init_for_dsmil(t, 2);
+        not_stisla_set_interpolation(t, configs[c].mode);
+        if (configs[c].transform < 0) {
+            not_stisla_fit_transform(t, offsets, n);
+        } else if (configs[c].fit) {
+            not_stisla_set_transform(t, (not_stisla_transform_kind_t)configs[c].transform, offsets, n);
+        } else {
+            not_stisla_set_transform(t, (not_stisla_transform_kind_t)configs[c].transform, NULL, 0);
+        }
+
+        uint64_t start = ns_now();
+        for (size_t i = 0; i < num_queries; ++i) {
+            not_stisla_search_offsets(offsets, n, keys[i], t);
+        }
+        uint64_t elapsed = ns_now() - start;
+
+        not_stisla_search_stats_t s;
+        not_stisla_get_search_stats(t, &s);
+        const double window = s.lookups ? (double)s.window_keys / s.lookups : 0.0;
+        printf("%-12s %6.1f ns/op, %zu escalations, mean window %.1f keys\n", configs[c].name,
+               (double)elapsed / num_queries, s.escalations, window);
+        if (configs[c].transform == NOT_STISLA_TRANSFORM_LOG) {
+            *(configs[c].fit ? &log_fitted_window : &log_window) = window;
+        }
+        not_stisla_anchor_table_destroy(t);
+    }
+
+    /* A fitted shift the learning search threw away would tie the two log rows */
+    assert(log_fitted_window < log_window && "Learning search discarded the fitted log transform");
+
+    /* RadixSpline on the same data: knots follow the curve instead of anchors */
+    not_stisla_spline_t* spline = not_stisla_spline_build(offsets, n, 32, 0);
+    assert(spline && "Failed to build spline");
+    uint64_t start = ns_now();
+    for (size_t i = 0; i < num_queries; ++i) {
+        not_stisla_spline_search(spline, offsets, keys[i]);
+    }
+    uint64_t elapsed = ns_now() - start;
+    size_t knots = 0, max_error = 0;
+    not_stisla_spline_get_stats(spline, &knots, NULL, &max_error);
+    printf("%-12s %6.1f ns/op, %zu knots, window %zu keys\n", "radixspline",
+           (double)elapsed / num_queries, knots, 2 * max_error + 1);
+    not_stisla_spline_destroy(spline);
+
+    free(keys);
+    free(offsets);
+}
+
+static int compare_keys(const void* a, const void* b) {
+    const int64_t x = *(const int64_t*)a;
+    const int64_t y = *(const int64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/* Unsorted load: qsort then build vs fused radix sort + spline */
+static void benchmark_ingestion(size_t n) {
+    int64_t* raw = malloc(n * sizeof(int64_t));
+    int64_t* keys = malloc(n * sizeof(int64_t));
+    size_t* perm = malloc(n * sizeof(size_t));
+    assert(raw && keys && perm && "Failed to allocate memory");
+
+    srand(17);
+    for (size_t i = 0; i < n; ++i) {
+        raw[i] = (int64_t)(((uint64_t)rand() << 31) ^ (uint64_t)rand());
+    }
+
+    printf("\n📥 Ingestion (%zu unsorted keys):\n", n);
+
+    memcpy(keys, raw, n * sizeof(int64_t));
+    uint64_t start = ns_now();
+    qsort(keys, n, sizeof(int64_t), compare_keys);
+    not_stisla_spline_t* spline = not_stisla_spline_build(keys, n, 32, 0);
+    uint64_t elapsed = ns_now() - start;
+    assert(spline && "Failed to build spline");
+    printf("qsort + build:     %.1f ms\n", elapsed / 1e6);
+    not_stisla_spline_destroy(spline);
+
+    memcpy(keys, raw, n * sizeof(int64_t));
+    start = ns_now();
+    spline = not_stisla_ingest(keys, n, NULL, 32, 0);
+    elapsed = ns_now() - start;
+    assert(spline && "Failed to ingest keys");
+    printf("radix ingest:      %.1f ms\n", elapsed / 1e6);
+    not_stisla_spline_destroy(spline);
+
+    memcpy(keys, raw, n * sizeof(int64_t));
+    start = ns_now();
+    spline = not_stisla_ingest(keys, n, perm, 32, 0);
+    elapsed = ns_now() - start;
+    assert(spline && "Failed to ingest keys");
+    printf("with permutation:  %.1f ms\n", elapsed / 1e6);
+    not_stisla_spline_destroy(spline);
+
+    free(perm);
+    free(keys);
+    free(raw);
+}
+
+/* First queries on a fresh table: endpoints only vs seeded anchors */
+static void benchmark_cold_start(size_t num_queries) {
+    const size_t n = 1000000;
+    int64_t* offsets = malloc(n * sizeof(int64_t));
+    int64_t* keys = malloc(num_queries * sizeof(int64_t));
+    assert(offsets && keys && "Failed to allocate memory");
+    generate_offsets_data(offsets, n);
+
+    srand(11);
+    for (size_t i = 0; i < num_queries; ++i) {
+        keys[i] = offsets[(size_t)rand() % n];
+    }
+
+    printf("\n🚀 Cold Start (first %zu queries, offsets):\n", num_queries);
+    for (int seeded = 0; seeded <= 1; ++seeded) {
+        not_stisla_anchor_table_t* t = not_stisla_anchor_table_create();
+        assert(t && "Failed to create anchor table");
+        not_stisla_init_for_dsmil(t, 2);
+        not_stisla_set_transform(t, NOT_STISLA_TRANSFORM_NONE, offsets, n);
+
+        uint64_t start = ns_now();
+        if (seeded) {
+            not_stisla_anchor_table_seed(t, offsets, n, 0, 8);
+        }
+        for (size_t i = 0; i < num_queries; ++i) {
+            not_stisla_search_offsets(offsets, n, keys[i], t);
+        }
+        uint64_t elapsed = ns_now() - start;
+
+        not_stisla_search_stats_t s;
+        not_stisla_get_search_stats(t, &s);
+        printf("%-12s %6.1f ns/op (seeding included), mean window %.1f keys\n",
+               seeded ? "seeded" : "endpoints", (double)elapsed / num_queries,
+               s.lookups ? (double)s.window_keys / s.lookups : 0.0);
+        not_stisla_anchor_table_destroy(t);
+    }
+
+    free(keys);
+    free(offsets);
+}
+
+/* Record a trace of learning searches on offsets for tools/trace_report */
+static void trace_offsets_searches(const char* path, size_t num_queries) {
+    FILE* trace = fopen(path, "wb");
+    if (!trace) {
+        perror(path);
+        return;
+    }
+    if (!not_stisla_trace_set_hook(not_stisla_trace_write, trace)) {
+        printf("\n🔎 Trace: library built without trace points (rebuild with make TRACE=1)\n");
+        fclose(trace);
+        return;
+    }
+
+    const size_t n = 1000000;
+    int64_t* offsets = malloc(n * sizeof(int64_t));
+    assert(offsets && "Failed to allocate memory");
+    generate_offsets_data(offsets, n);
+    not_stisla_anchor_table_t* t = not_stisla_anchor_table_create();
+    assert(t && "Failed to create anchor table");
+    not_stisla_init_for_dsmil(t, 2);
+
+    srand(23);
+    for (size_t i = 0; i < num_queries; ++i) {
+        not_stisla_search_offsets(offsets, n, offsets[(size_t)rand() % n], t);
+    }
+
+    not_stisla_trace_set_hook(NULL, NULL);
+    fclose(trace);
+    printf("\n🔎 Trace: %zu offsets searches written to %s\n", num_queries, path);
+
+    not_stisla_anchor_table_destroy(t);
+    free(offsets);
+}
+
 int main() {
     printf("🎯 DSMIL NOT_STISLA Benchmark Suite\n");
     printf("Version: %s\n", not_stisla_version());
@@ -70,12 +288,18 @@ int main() {
     not_stisla_anchor_table_t* table = not_stisla_anchor_table_create();
     assert(table && "Failed to create anchor table");
 
+    /* Hardware counters, if this machine lets us read them */
+    perf_counters_t pc;
+    perf_counters_open(&pc);
+    perf_sample_t bin_ctr, not_stisla_ctr, frozen_ctr, live_ctr, spline_ctr, shared_ctr, app_ctr;
+
     /* Warm-up */
     for (size_t i = 0; i < 1000; ++i) {
         not_stisla_search(data, DATA_SIZE, queries[i], table, 8);
     }
 
     /* Benchmark binary search */
+    perf_counters_start(&pc);
     uint64_t bin_start = ns_now();
     size_t bin_found = 0;
     for (size_t i = 0; i < NUM_QUERIES; ++i) {
@@ -84,8 +308,10 @@ int main() {
         }
     }
     uint64_t bin_time = ns_now() - bin_start;
+    perf_counters_stop(&pc, &bin_ctr);
 
     /* Benchmark NOT_STISLA */
+    perf_counters_start(&pc);
     uint64_t not_stisla_start = ns_now();
     size_t not_stisla_found = 0;
     for (size_t i = 0; i < NUM_QUERIES; ++i) {
@@ -94,6 +320,7 @@ int main() {
         }
     }
     uint64_t not_stisla_time = ns_now() - not_stisla_start;
+    perf_counters_stop(&pc, &not_stisla_ctr);
 
     /* Results */
     double bin_ns_per_op = (double)bin_time / NUM_QUERIES;
@@ -113,6 +340,166 @@ int main() {
     printf("Anchors learned:    %zu\n", anchors);
     printf("Memory usage:       %zu bytes\n", memory);
 
+    not_stisla_search_stats_t search_stats;
+    not_stisla_get_search_stats(table, &search_stats);
+    printf("Window escalations: %zu of %zu lookups\n", search_stats.escalations, search_stats.lookups);
+    printf("Mean window:        %.1f keys\n",
+           search_stats.lookups ? (double)search_stats.window_keys / search_stats.lookups : 0.0);
+
+    /* Frozen table: compiled from the learned one, read-only search */
+    not_stisla_frozen_t* frozen = not_stisla_freeze(table, data, DATA_SIZE);
+    assert(frozen && "Failed to freeze anchor table");
+
+    perf_counters_start(&pc);
+    uint64_t frozen_start = ns_now();
+    size_t frozen_found = 0;
+    for (size_t i = 0; i < NUM_QUERIES; ++i) {
+        if (not_stisla_frozen_search(frozen, data, queries[i]) != NOT_STISLA_NOT_FOUND) {
+            frozen_found++;
+        }
+    }
+    uint64_t frozen_time = ns_now() - frozen_start;
+    perf_counters_stop(&pc, &frozen_ctr);
+    printf("\n🧊 Frozen Table (read-only):\n");
+    printf("Frozen search:     %.1f ns/op (%zu found)\n", (double)frozen_time / NUM_QUERIES, frozen_found);
+    printf("Frozen size:       %zu bytes\n", not_stisla_frozen_size_bytes(frozen));
+    not_stisla_frozen_destroy(frozen);
+
+    /* Live index: prebuilt model, never cold and never learning */
+    not_stisla_live_t* live = not_stisla_live_create(data, DATA_SIZE, 8, 0);
+    assert(live && "Failed to create live index");
+
+    perf_counters_start(&pc);
+    uint64_t live_start = ns_now();
+    size_t live_found = 0;
+    for (size_t i = 0; i < NUM_QUERIES; ++i) {
+        if (not_stisla_live_search(live, queries[i]) != NOT_STISLA_NOT_FOUND) {
+            live_found++;
+        }
+    }
+    uint64_t live_time = ns_now() - live_start;
+    perf_counters_stop(&pc, &live_ctr);
+    printf("\n🔁 Live Index (background rebuild):\n");
+    printf("Live search:       %.1f ns/op (%zu found)\n", (double)live_time / NUM_QUERIES, live_found);
+
+    not_stisla_live_rebuild(live, data, DATA_SIZE);
+    if (!not_stisla_live_wait(live)) {
+        printf("Live rebuild:      failed, previous model kept\n");
+    }
+    printf("Model generation:  %zu\n", not_stisla_live_generation(live));
+    not_stisla_live_destroy(live);
+
+    /* RadixSpline: one-pass build, radix slot + segment + bounded window */
+    uint64_t spline_build_start = ns_now();
+    not_stisla_spline_t* spline = not_stisla_spline_build(data, DATA_SIZE, 32, 0);
+    uint64_t spline_build_time = ns_now() - spline_build_start;
+    assert(spline && "Failed to build spline");
+
+    perf_counters_start(&pc);
+    uint64_t spline_start = ns_now();
+    size_t spline_found = 0;
+    for (size_t i = 0; i < NUM_QUERIES; ++i) {
+        if (not_stisla_spline_search(spline, data, queries[i]) != NOT_STISLA_NOT_FOUND) {
+            spline_found++;
+        }
+    }
+    uint64_t spline_time = ns_now() - spline_start;
+    perf_counters_stop(&pc, &spline_ctr);
+    size_t spline_points = 0, spline_bytes = 0, spline_error = 0;
+    not_stisla_spline_get_stats(spline, &spline_points, &spline_bytes, &spline_error);
+    printf("\n🦴 RadixSpline (max error %zu):\n", spline_error);
+    printf("Spline search:     %.1f ns/op (%zu found)\n", (double)spline_time / NUM_QUERIES, spline_found);
+    printf("Spline build:      %.2f ms\n", spline_build_time / 1e6);
+    printf("Spline knots:      %zu (%zu bytes)\n", spline_points, spline_bytes);
+    not_stisla_spline_destroy(spline);
+
+    /* Same spline fitted on every online CPU */
+    spline_build_start = ns_now();
+    spline = not_stisla_spline_build_parallel(data, DATA_SIZE, 32, 0, 0);
+    spline_build_time = ns_now() - spline_build_start;
+    assert(spline && "Failed to build spline in parallel");
+    not_stisla_spline_get_stats(spline, &spline_points, NULL, NULL);
+    printf("Parallel build:    %.2f ms (%zu knots)\n", spline_build_time / 1e6, spline_points);
+    not_stisla_spline_destroy(spline);
+
+    /* Shared table: learned through one handle, used through another
+     * (processes would map the same shm_open() region instead) */
+    size_t shared_len = not_stisla_shared_size(64);
+    void* shared_mem = aligned_alloc(64, (shared_len + 63) & ~(size_t)63);
+    assert(shared_mem && "Failed to allocate shared region");
+    not_stisla_shared_t* learner = not_stisla_shared_init(shared_mem, shared_len, data, DATA_SIZE);
+    not_stisla_shared_t* attached = not_stisla_shared_attach(shared_mem, shared_len);
+    assert(learner && attached && "Failed to set up shared table");
+
+    for (size_t i = 0; i < NUM_QUERIES; ++i) {
+        not_stisla_shared_search(learner, data, DATA_SIZE, queries[i], 8);
+    }
+    perf_counters_start(&pc);
+    uint64_t shared_start = ns_now();
+    size_t shared_found = 0;
+    for (size_t i = 0; i < NUM_QUERIES; ++i) {
+        if (not_stisla_shared_search(attached, data, DATA_SIZE, queries[i], 8) != NOT_STISLA_NOT_FOUND) {
+            shared_found++;
+        }
+    }
+    uint64_t shared_time = ns_now() - shared_start;
+    perf_counters_stop(&pc, &shared_ctr);
+    size_t shared_anchors = 0;
+    not_stisla_shared_get_stats(attached, &shared_anchors, NULL, NULL);
+    printf("\n🤝 Shared Table (attached, pre-learned):\n");
+    printf("Shared search:     %.1f ns/op (%zu found)\n", (double)shared_time / NUM_QUERIES, shared_found);
+    printf("Shared anchors:    %zu\n", shared_anchors);
+    free(shared_mem);
+
+    /* Appendable array: same keys appended in batches, then searched */
+    not_stisla_append_t* app = not_stisla_append_create(DATA_SIZE, 32);
+    assert(app && "Failed to create appendable array");
+    uint64_t append_start = ns_now();
+    for (size_t pos = 0; pos < DATA_SIZE; pos += 1000) {
+        not_stisla_append(app, data + pos, DATA_SIZE - pos < 1000 ? DATA_SIZE - pos : 1000);
+    }
+    uint64_t append_time = ns_now() - append_start;
+
+    perf_counters_start(&pc);
+    uint64_t app_start = ns_now();
+    size_t app_found = 0;
+    for (size_t i = 0; i < NUM_QUERIES; ++i) {
+        if (not_stisla_append_search(app, queries[i]) != NOT_STISLA_NOT_FOUND) {
+            app_found++;
+        }
+    }
+    uint64_t app_time = ns_now() - app_start;
+    perf_counters_stop(&pc, &app_ctr);
+    printf("\n📎 Appendable Array (single writer):\n");
+    printf("Append:            %.1f ns/key\n", (double)append_time / DATA_SIZE);
+    printf("Append search:     %.1f ns/op (%zu found)\n", (double)app_time / NUM_QUERIES, app_found);
+    not_stisla_append_destroy(app);
+
+    /* Same queries, same data: binary search is the reference row */
+    printf("\n🧮 Hardware Counters (per lookup):\n");
+    if (pc.any) {
+        perf_counters_print_header("search");
+        perf_counters_print("binary search", &bin_ctr, NUM_QUERIES);
+        perf_counters_print("not_stisla", &not_stisla_ctr, NUM_QUERIES);
+        perf_counters_print("frozen", &frozen_ctr, NUM_QUERIES);
+        perf_counters_print("live", &live_ctr, NUM_QUERIES);
+        perf_counters_print("radixspline", &spline_ctr, NUM_QUERIES);
+        perf_counters_print("shared", &shared_ctr, NUM_QUERIES);
+        perf_counters_print("appendable", &app_ctr, NUM_QUERIES);
+    } else {
+        printf("Unavailable (no perf_event_open access; check perf_event_paranoid)\n");
+    }
+    perf_counters_close(&pc);
+
+    benchmark_offsets_interpolation(NUM_QUERIES);
+    benchmark_cold_start(1000);
+    benchmark_ingestion(4000000);
+
+    const char* trace_path = getenv("NOT_STISLA_TRACE_FILE");
+    if (trace_path) {
+        trace_offsets_searches(trace_path, NUM_QUERIES);
+    }
+
     printf("\n✅ Benchmark completed successfully!\n");
     printf("NOT_STISLA delivers %.1fx actual speedup\n", speedup);
 
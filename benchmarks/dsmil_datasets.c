@@ -0,0 +1,155 @@
+/**
+ * DSMIL Datasets - Seeded generators for the four DSMIL workload shapes
+ */
+
+#include "dsmil_datasets.h"
+#include <math.h>
+
+/* Telemetry: 1 ms sampling in nanoseconds from a fixed epoch */
+#define DSMIL_TELEMETRY_EPOCH 1700000000000000000LL
+#define DSMIL_TELEMETRY_PERIOD 1000000LL
+
+/* IDs: first ID and the size of a deleted block */
+#define DSMIL_IDS_BASE 1000000LL
+#define DSMIL_IDS_BLOCK 1000000LL
+
+/* Offsets: smallest record and growth over the whole array */
+#define DSMIL_OFFSETS_MIN_SIZE 64.0
+#define DSMIL_OFFSETS_GROWTH 8.0
+
+/* Events: mean gap between bursts, nanoseconds */
+#define DSMIL_EVENTS_BURST_GAP 1000000.0
+
+/* splitmix64: tiny, fast, identical everywhere */
+typedef struct {
+    uint64_t s;
+} dsmil_rng_t;
+
+static inline uint64_t dsmil_rng_next(dsmil_rng_t* r) {
+    uint64_t z = (r->s += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/* Uniform in (0, 1) */
+static inline double dsmil_rng_unit(dsmil_rng_t* r) {
+    return ((double)(dsmil_rng_next(r) >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+static inline double dsmil_rng_exponential(dsmil_rng_t* r, double mean) {
+    return -mean * log(dsmil_rng_unit(r));
+}
+
+static void dsmil_generate_telemetry(const dsmil_data_config_t* cfg, dsmil_rng_t* r, int64_t* out) {
+    /* Jitter stays under half a period so samples never reorder */
+    double jitter = 0.1 * cfg->skew;
+    if (jitter > 0.45) jitter = 0.45;
+    const double dropout_p = 0.001 * cfg->skew;
+
+    int64_t tick = DSMIL_TELEMETRY_EPOCH;
+    for (size_t i = 0; i < cfg->n; ++i) {
+        /* Sensor dropout: whole periods pass without a sample */
+        if (dsmil_rng_unit(r) < dropout_p) {
+            tick += (int64_t)dsmil_rng_exponential(r, 100.0 * cfg->skew) * DSMIL_TELEMETRY_PERIOD;
+        }
+        const double offset = (2.0 * dsmil_rng_unit(r) - 1.0) * jitter * (double)DSMIL_TELEMETRY_PERIOD;
+        out[i] = tick + (int64_t)offset;
+        tick += DSMIL_TELEMETRY_PERIOD;
+    }
+}
+
+static void dsmil_generate_ids(const dsmil_data_config_t* cfg, dsmil_rng_t* r, int64_t* out) {
+    const double gap_p = 0.05 * cfg->skew;
+    const double block_p = 0.0005 * cfg->skew;
+
+    int64_t id = DSMIL_IDS_BASE;
+    for (size_t i = 0; i < cfg->n; ++i) {
+        out[i] = id;
+        const double u = dsmil_rng_unit(r);
+        if (u < block_p) {
+            id += DSMIL_IDS_BLOCK;                                  /* Deleted range */
+        } else if (u < block_p + gap_p) {
+            id += 2 + (int64_t)dsmil_rng_exponential(r, 50.0);     /* Sparse region */
+        } else {
+            id += 1;
+        }
+    }
+}
+
+static void dsmil_generate_offsets(const dsmil_data_config_t* cfg, dsmil_rng_t* r, int64_t* out) {
+    /* Pareto record sizes (heavier tail with more skew) on a scale growing
+     * exponentially along the file, as in log-structured segments */
+    double alpha = 2.5 - cfg->skew;
+    if (alpha < 1.1) alpha = 1.1;
+    const double growth = DSMIL_OFFSETS_GROWTH * cfg->skew / (double)cfg->n;
+
+    double offset = 0.0;
+    for (size_t i = 0; i < cfg->n; ++i) {
+        out[i] = (int64_t)offset;
+        double size = DSMIL_OFFSETS_MIN_SIZE * pow(dsmil_rng_unit(r), -1.0 / alpha) * exp(growth * (double)i);
+        if (size > 1e12) size = 1e12;
+        if (offset > 4e18) size = 0.0;  /* Keep huge or harsh configs inside int64 */
+        offset += floor(size) + 1.0;
+    }
+}
+
+static void dsmil_generate_events(const dsmil_data_config_t* cfg, dsmil_rng_t* r, int64_t* out) {
+    /* Longer bursts and more same-nanosecond events with more skew */
+    const double burst_mean = 1.0 + 20.0 * cfg->skew;
+    double dup_p = 0.3 * cfg->skew;
+    if (dup_p > 0.9) dup_p = 0.9;
+
+    int64_t t = DSMIL_TELEMETRY_EPOCH;
+    size_t i = 0;
+    while (i < cfg->n) {
+        t += 1 + (int64_t)dsmil_rng_exponential(r, DSMIL_EVENTS_BURST_GAP);
+        const size_t burst = 1 + (size_t)dsmil_rng_exponential(r, burst_mean);
+        for (size_t b = 0; b < burst && i < cfg->n; ++b, ++i) {
+            if (b > 0 && dsmil_rng_unit(r) >= dup_p) t += 1 + (int64_t)(dsmil_rng_next(r) % 100);
+            out[i] = t;
+        }
+    }
+}
+
+bool dsmil_generate(dsmil_data_kind_t kind, const dsmil_data_config_t* cfg, int64_t* out) {
+    if (!cfg || !out || cfg->n == 0) return false;
+
+    dsmil_rng_t r = { cfg->seed ^ ((uint64_t)kind << 56) };
+    switch (kind) {
+        case DSMIL_DATA_TELEMETRY:
+            dsmil_generate_telemetry(cfg, &r, out);
+            return true;
+        case DSMIL_DATA_IDS:
+            dsmil_generate_ids(cfg, &r, out);
+            return true;
+        case DSMIL_DATA_OFFSETS:
+            dsmil_generate_offsets(cfg, &r, out);
+            return true;
+        case DSMIL_DATA_EVENTS:
+            dsmil_generate_events(cfg, &r, out);
+            return true;
+        default:
+            return false;
+    }
+}
+
+void dsmil_sample_queries(const int64_t* arr, size_t n, int64_t* queries, size_t count, double miss_ratio,
+                          uint64_t seed) {
+    dsmil_rng_t r = { seed };
+    for (size_t q = 0; q < count; ++q) {
+        const size_t i = (size_t)(dsmil_rng_next(&r) % n);
+        if (dsmil_rng_unit(&r) >= miss_ratio) {
+            queries[q] = arr[i];
+        } else if (i + 1 < n && arr[i + 1] - arr[i] > 1) {
+            queries[q] = arr[i] + 1 + (int64_t)(dsmil_rng_next(&r) % (uint64_t)(arr[i + 1] - arr[i] - 1));
+        } else {
+            queries[q] = arr[n - 1] + 1;
+        }
+    }
+}
+
+const char* dsmil_data_name(dsmil_data_kind_t kind) {
+    static const char* const names[DSMIL_DATA_COUNT] = { "telemetry", "ids", "offsets", "events" };
+    return ((unsigned)kind < DSMIL_DATA_COUNT) ? names[kind] : "unknown";
+}
@@ -0,0 +1,53 @@
+/**
+ * DSMIL Datasets - Seeded generators for the four DSMIL workload shapes
+ *
+ * Each generator matches the data one of the search wrappers is tuned for:
+ * - Telemetry: periodic samples with jitter and dropouts
+ * - IDs: dense runs broken by small gaps and deleted blocks
+ * - Offsets: cumulative power-law sizes growing exponentially
+ * - Events: Poisson bursts with duplicate timestamps
+ *
+ * Output is sorted ascending and depends only on the config, so runs on
+ * different machines compare the same keys.
+ */
+
+#ifndef DSMIL_DATASETS_H
+#define DSMIL_DATASETS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+typedef enum {
+    DSMIL_DATA_TELEMETRY = 0,  /* Matches not_stisla_search_telemetry */
+    DSMIL_DATA_IDS = 1,        /* Matches not_stisla_search_ids */
+    DSMIL_DATA_OFFSETS = 2,    /* Matches not_stisla_search_offsets */
+    DSMIL_DATA_EVENTS = 3,     /* Matches not_stisla_search_events */
+    DSMIL_DATA_COUNT
+} dsmil_data_kind_t;
+
+typedef struct {
+    size_t n;       /* Keys to generate */
+    uint64_t seed;  /* Same seed, same keys */
+    double skew;    /* Shape strength: 0 = nearly uniform, 1 = typical, larger = harsher */
+} dsmil_data_config_t;
+
+/**
+ * @brief Fill out[0..n) with sorted keys of the given shape
+ * @return false on an unknown kind or n == 0
+ */
+bool dsmil_generate(dsmil_data_kind_t kind, const dsmil_data_config_t* cfg, int64_t* out);
+
+/**
+ * @brief Draw lookup keys from a generated array
+ *
+ * Hits are keys of the array at uniform positions; a miss_ratio share are
+ * keys strictly between two neighbours (or past the end when no gap exists).
+ */
+void dsmil_sample_queries(const int64_t* arr, size_t n, int64_t* queries, size_t count, double miss_ratio,
+                          uint64_t seed);
+
+/** @brief Short name of a dataset kind ("telemetry", "ids", ...) */
+const char* dsmil_data_name(dsmil_data_kind_t kind);
+
+#endif /* DSMIL_DATASETS_H */
@@ -0,0 +1,148 @@
+/**
+ * Benchmark hardware counters - perf_event_open around measured sections
+ *
+ * Counts cycles, instructions, L1D and LLC misses, branch misses and dTLB
+ * misses in user space for the calling thread. Each counter is opened on its
+ * own, so a PMU without one of them still reports the rest; without
+ * perf_event_open (non-Linux, seccomp, perf_event_paranoid > 2, no PMU in a
+ * VM) every counter reads as unavailable and the benchmarks run unchanged.
+ *
+ * Include after defining _DEFAULT_SOURCE (for syscall()).
+ */
+
+#ifndef NOT_STISLA_PERF_COUNTERS_H
+#define NOT_STISLA_PERF_COUNTERS_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+enum {
+    PERF_CTR_CYCLES,
+    PERF_CTR_INSTRUCTIONS,
+    PERF_CTR_L1D_MISSES,
+    PERF_CTR_LLC_MISSES,
+    PERF_CTR_BRANCH_MISSES,
+    PERF_CTR_DTLB_MISSES,
+    PERF_CTR_COUNT
+};
+
+static const char* const perf_counter_names[PERF_CTR_COUNT] = {
+    "cycles", "instr", "L1D miss", "LLC miss", "br miss", "dTLB miss"
+};
+
+typedef struct {
+    int fds[PERF_CTR_COUNT];
+    bool any;
+} perf_counters_t;
+
+/* Counts of one section; valid[c] is false for a counter that could not run */
+typedef struct {
+    double values[PERF_CTR_COUNT];
+    bool valid[PERF_CTR_COUNT];
+} perf_sample_t;
+
+#ifdef __linux__
+static int perf_counter_open(uint32_t type, uint64_t config) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+#define PERF_CACHE_READ_MISS(cache) \
+    ((cache) | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16))
+#endif
+
+static void perf_counters_open(perf_counters_t* pc) {
+    pc->any = false;
+    for (int c = 0; c < PERF_CTR_COUNT; ++c) pc->fds[c] = -1;
+#ifdef __linux__
+    pc->fds[PERF_CTR_CYCLES] = perf_counter_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    pc->fds[PERF_CTR_INSTRUCTIONS] = perf_counter_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    pc->fds[PERF_CTR_L1D_MISSES] = perf_counter_open(PERF_TYPE_HW_CACHE, PERF_CACHE_READ_MISS(PERF_COUNT_HW_CACHE_L1D));
+    pc->fds[PERF_CTR_LLC_MISSES] = perf_counter_open(PERF_TYPE_HW_CACHE, PERF_CACHE_READ_MISS(PERF_COUNT_HW_CACHE_LL));
+    pc->fds[PERF_CTR_BRANCH_MISSES] = perf_counter_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    pc->fds[PERF_CTR_DTLB_MISSES] = perf_counter_open(PERF_TYPE_HW_CACHE, PERF_CACHE_READ_MISS(PERF_COUNT_HW_CACHE_DTLB));
+    for (int c = 0; c < PERF_CTR_COUNT; ++c) pc->any = pc->any || pc->fds[c] >= 0;
+#endif
+}
+
+static void perf_counters_close(perf_counters_t* pc) {
+#ifdef __linux__
+    for (int c = 0; c < PERF_CTR_COUNT; ++c) {
+        if (pc->fds[c] >= 0) close(pc->fds[c]);
+        pc->fds[c] = -1;
+    }
+#endif
+    pc->any = false;
+}
+
+static inline void perf_counters_start(perf_counters_t* pc) {
+#ifdef __linux__
+    for (int c = 0; c < PERF_CTR_COUNT; ++c) {
+        if (pc->fds[c] < 0) continue;
+        ioctl(pc->fds[c], PERF_EVENT_IOC_RESET, 0);
+        ioctl(pc->fds[c], PERF_EVENT_IOC_ENABLE, 0);
+    }
+#else
+    (void)pc;
+#endif
+}
+
+/* Stop and read; counts are scaled up when the kernel multiplexed a counter */
+static inline void perf_counters_stop(perf_counters_t* pc, perf_sample_t* out) {
+    memset(out, 0, sizeof(*out));
+#ifdef __linux__
+    for (int c = 0; c < PERF_CTR_COUNT; ++c) {
+        if (pc->fds[c] >= 0) ioctl(pc->fds[c], PERF_EVENT_IOC_DISABLE, 0);
+    }
+    for (int c = 0; c < PERF_CTR_COUNT; ++c) {
+        uint64_t v[3];  /* value, time enabled, time running */
+        if (pc->fds[c] < 0 || read(pc->fds[c], v, sizeof(v)) != (ssize_t)sizeof(v) || v[2] == 0) continue;
+        out->values[c] = (v[2] < v[1]) ? (double)v[0] * (double)v[1] / (double)v[2] : (double)v[0];
+        out->valid[c] = true;
+    }
+#else
+    (void)pc;
+#endif
+}
+
+static void perf_counters_print_header(const char* title) {
+    printf("%-22s", title);
+    for (int c = 0; c < PERF_CTR_COUNT; ++c) printf(" %9s", perf_counter_names[c]);
+    printf(" %6s\n", "IPC");
+}
+
+/* One row of per-lookup counts */
+static void perf_counters_print(const char* label, const perf_sample_t* s, size_t ops) {
+    printf("%-22s", label);
+    for (int c = 0; c < PERF_CTR_COUNT; ++c) {
+        if (s->valid[c]) {
+            printf(" %9.2f", s->values[c] / (double)ops);
+        } else {
+            printf(" %9s", "-");
+        }
+    }
+    if (s->valid[PERF_CTR_CYCLES] && s->valid[PERF_CTR_INSTRUCTIONS] && s->values[PERF_CTR_CYCLES] > 0) {
+        printf(" %6.2f\n", s->values[PERF_CTR_INSTRUCTIONS] / s->values[PERF_CTR_CYCLES]);
+    } else {
+        printf(" %6s\n", "-");
+    }
+}
+
+#endif /* NOT_STISLA_PERF_COUNTERS_H */
@@ -0,0 +1,361 @@
+/**
+ * NOT_STISLA Phase Benchmark - Cycle breakdown of one search
+ *
+ * Times the anchor lookup, the interpolation and the window search alone and
+ * combined, over identical precomputed inputs, for several dataset shapes.
+ *
+ * Warm: each phase loops over a query batch with keys and anchors cached;
+ *       best of several repetitions, cycles per query.
+ * Cold: each query is timed alone after flushing every line it can touch;
+ *       median and p99 after subtracting the timer's own cost.
+ * Counters: hardware events per query over one warm batch, where available.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE
+
+#include "../src/not_stisla_internal.h"
+#include "perf_counters.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+
+#define PHASE_KEYS (1u << 20)     /* 8 MB of keys, larger than L2 */
+#define PHASE_ANCHORS 256         /* The seeding budget */
+#define PHASE_TOL 8               /* The library's default tolerance */
+#define PHASE_WARM_QUERIES 4096
+#define PHASE_WARM_REPS 16
+#define PHASE_COLD_QUERIES 2048
+
+/* Serialized cycle counter: nothing retires across the reads. Elsewhere the
+ * library's clock is used and cold runs are skipped (no cache flush). */
+#if defined(__x86_64__) || defined(__i386__)
+#define PHASE_HAVE_FLUSH 1
+static inline uint64_t cycles_begin(void) {
+    _mm_lfence();
+    const uint64_t t = __rdtsc();
+    _mm_lfence();
+    return t;
+}
+
+static inline uint64_t cycles_end(void) {
+    unsigned aux;
+    const uint64_t t = __rdtscp(&aux);
+    _mm_lfence();
+    return t;
+}
+
+static void flush_range(const void* p, size_t bytes) {
+    const char* c = (const char*)((uintptr_t)p & ~(uintptr_t)63);
+    const char* end = (const char*)p + bytes;
+    for (; c < end; c += 64) _mm_clflush(c);
+}
+
+static inline void flush_fence(void) {
+    _mm_mfence();
+}
+#else
+#define PHASE_HAVE_FLUSH 0
+static inline uint64_t cycles_begin(void) {
+    return not_stisla_cycles();
+}
+
+static inline uint64_t cycles_end(void) {
+    return not_stisla_cycles();
+}
+#endif
+
+/* One query with every intermediate result precomputed, so each phase can
+ * be timed on its own inputs */
+typedef struct {
+    int64_t key;
+    size_t seg;
+    size_t pred;
+    size_t lo;
+    size_t hi;
+} phase_query_t;
+
+typedef struct {
+    const int64_t* arr;
+    size_t n;
+    const not_stisla_anchor_t* anchors;
+    size_t num_anchors;
+} phase_model_t;
+
+static volatile size_t sink;
+
+/* The phases, exactly as not_stisla_search composes them for learned segments */
+static inline size_t phase_anchor(const phase_model_t* m, int64_t key) {
+    size_t a = not_stisla_anchor_lower(m->anchors, m->num_anchors, key);
+    return (a + 1 >= m->num_anchors) ? m->num_anchors - 2 : a;
+}
+
+static inline size_t phase_interpolate(const phase_model_t* m, size_t seg, int64_t key) {
+    const not_stisla_anchor_t* l = &m->anchors[seg];
+    const not_stisla_anchor_t* r = &m->anchors[seg + 1];
+    return (size_t)not_stisla_interpolate(l->v, r->v, l->i, r->i, key);
+}
+
+static inline void phase_bounds(const phase_model_t* m, size_t seg, size_t pred, size_t* lo, size_t* hi) {
+    const size_t l_i = m->anchors[seg].i;
+    const size_t r_i = m->anchors[seg + 1].i;
+    *lo = (pred < l_i + PHASE_TOL) ? l_i : pred - PHASE_TOL;
+    *hi = (pred + PHASE_TOL > r_i) ? r_i : pred + PHASE_TOL;
+}
+
+static inline size_t phase_window(const phase_model_t* m, size_t seg, size_t lo, size_t hi, int64_t key) {
+    size_t result = not_stisla_local_search(m->arr, lo, hi, key);
+    if (result == NOT_STISLA_NOT_FOUND) {
+        const size_t l_i = m->anchors[seg].i;
+        const size_t r_i = m->anchors[seg + 1].i;
+        if (key < m->arr[lo] && lo > l_i) {
+            result = not_stisla_local_search(m->arr, l_i, lo - 1, key);
+        } else if (key > m->arr[hi] && hi < r_i) {
+            result = not_stisla_local_search(m->arr, hi + 1, r_i, key);
+        }
+    }
+    return result;
+}
+
+static inline size_t phase_model(const phase_model_t* m, int64_t key) {
+    const size_t seg = phase_anchor(m, key);
+    const size_t pred = phase_interpolate(m, seg, key);
+    size_t lo, hi;
+    phase_bounds(m, seg, pred, &lo, &hi);
+    return phase_window(m, seg, lo, hi, key);
+}
+
+static inline size_t phase_binary(const phase_model_t* m, int64_t key) {
+    size_t lo = 0, hi = m->n;
+    while (lo < hi) {
+        const size_t mid = lo + ((hi - lo) >> 1);
+        if (m->arr[mid] < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/* Warm: best batch over several repetitions; q is the loop variable */
+#define PHASE_TIME_WARM(out, queries, count, expr) \
+    do { \
+        uint64_t best = UINT64_MAX; \
+        for (int rep = 0; rep < PHASE_WARM_REPS; ++rep) { \
+            size_t acc = 0; \
+            const uint64_t t0 = cycles_begin(); \
+            for (size_t q = 0; q < (count); ++q) acc += (expr); \
+            const uint64_t t1 = cycles_end(); \
+            sink += acc; \
+            if (t1 - t0 < best) best = t1 - t0; \
+        } \
+        (out) = (double)best / (double)(count); \
+    } while (0)
+
+/* Counters: one warm batch after a warm-up batch */
+#define PHASE_COUNT(pc, label, count, expr) \
+    do { \
+        perf_sample_t ctr; \
+        size_t acc = 0; \
+        for (size_t q = 0; q < (count); ++q) acc += (expr); \
+        perf_counters_start(pc); \
+        for (size_t q = 0; q < (count); ++q) acc += (expr); \
+        perf_counters_stop(pc, &ctr); \
+        sink += acc; \
+        perf_counters_print(label, &ctr, (count)); \
+    } while (0)
+
+/* Cold: one query per sample, its cache lines flushed first */
+#define PHASE_TIME_COLD(samples, m, queries, count, overhead, expr) \
+    do { \
+        for (size_t q = 0; q < (count); ++q) { \
+            phase_flush((m), &(queries)[q]); \
+            const uint64_t t0 = cycles_begin(); \
+            const size_t r = (expr); \
+            const uint64_t t1 = cycles_end(); \
+            sink += r; \
+            (samples)[q] = (t1 - t0 > (overhead)) ? t1 - t0 - (overhead) : 0; \
+        } \
+    } while (0)
+
+#if PHASE_HAVE_FLUSH
+/* Evict what any phase of this query may read: the anchors, the key's
+ * segment, and the binary search path through the array */
+static void phase_flush(const phase_model_t* m, const phase_query_t* q) {
+    flush_range(m->anchors, m->num_anchors * sizeof(not_stisla_anchor_t));
+    const size_t l_i = m->anchors[q->seg].i;
+    const size_t r_i = m->anchors[q->seg + 1].i;
+    flush_range(&m->arr[l_i], (r_i - l_i + 1) * sizeof(int64_t));
+
+    size_t lo = 0, hi = m->n;
+    while (lo < hi) {
+        const size_t mid = lo + ((hi - lo) >> 1);
+        _mm_clflush(&m->arr[mid]);
+        if (m->arr[mid] < q->key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    flush_fence();
+}
+#endif
+
+static int compare_u64(const void* a, const void* b) {
+    const uint64_t x = *(const uint64_t*)a;
+    const uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static void print_row(const char* name, double warm, uint64_t* cold, size_t count) {
+    printf("%-22s %10.1f", name, warm);
+    if (cold) {
+        qsort(cold, count, sizeof(uint64_t), compare_u64);
+        printf(" %10llu %10llu\n", (unsigned long long)cold[count / 2],
+               (unsigned long long)cold[(count * 99) / 100]);
+    } else {
+        printf(" %10s %10s\n", "-", "-");
+    }
+}
+
+/* Dataset shapes */
+static void generate_uniform(int64_t* arr, size_t n) {
+    for (size_t i = 0; i < n; ++i) arr[i] = (int64_t)i * 2;
+}
+
+static void generate_gapped(int64_t* arr, size_t n) {
+    arr[0] = 0;
+    for (size_t i = 1; i < n; ++i) arr[i] = arr[i - 1] + 1 + rand() % 63;
+}
+
+static void generate_offsets(int64_t* arr, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        arr[i] = (int64_t)(exp((double)i / (double)(n / 20)) * 1000.0) + (int64_t)i;
+    }
+}
+
+static void generate_clustered(int64_t* arr, size_t n) {
+    arr[0] = 0;
+    for (size_t i = 1; i < n; ++i) {
+        arr[i] = arr[i - 1] + ((i % 4096) == 0 ? 1000000000 : 1 + rand() % 4);
+    }
+}
+
+static void benchmark_dataset(const char* name, void (*generate)(int64_t*, size_t), perf_counters_t* pc) {
+    const size_t n = PHASE_KEYS;
+    int64_t* arr = malloc(n * sizeof(int64_t));
+    not_stisla_anchor_t* anchors = calloc(PHASE_ANCHORS, sizeof(not_stisla_anchor_t));
+    phase_query_t* queries = malloc(PHASE_WARM_QUERIES * sizeof(phase_query_t));
+    uint64_t* samples = malloc(PHASE_COLD_QUERIES * sizeof(uint64_t));
+    assert(arr && anchors && queries && samples && "Failed to allocate memory");
+
+    srand(42);
+    generate(arr, n);
+
+    /* Evenly spaced anchors, as a freshly seeded table would start */
+    for (size_t a = 0; a < PHASE_ANCHORS; ++a) {
+        const size_t i = (a + 1 == PHASE_ANCHORS) ? n - 1 : (n - 1) / (PHASE_ANCHORS - 1) * a;
+        anchors[a].v = arr[i];
+        anchors[a].i = i;
+    }
+    const phase_model_t m = { .arr = arr, .n = n, .anchors = anchors, .num_anchors = PHASE_ANCHORS };
+
+    double window_keys = 0.0;
+    for (size_t q = 0; q < PHASE_WARM_QUERIES; ++q) {
+        phase_query_t* pq = &queries[q];
+        pq->key = arr[(size_t)rand() % n];
+        pq->seg = phase_anchor(&m, pq->key);
+        pq->pred = phase_interpolate(&m, pq->seg, pq->key);
+        phase_bounds(&m, pq->seg, pq->pred, &pq->lo, &pq->hi);
+        window_keys += (double)(pq->hi - pq->lo + 1);
+    }
+
+    not_stisla_anchor_table_t* table = not_stisla_anchor_table_create();
+    assert(table && "Failed to create anchor table");
+    not_stisla_anchor_table_seed(table, arr, n, PHASE_ANCHORS, PHASE_TOL);
+
+    printf("\n%s (%zu keys, %d anchors, mean window %.1f keys)\n", name, n, PHASE_ANCHORS,
+           window_keys / PHASE_WARM_QUERIES);
+    printf("%-22s %10s %10s %10s\n", "phase (cycles)", "warm", "cold p50", "cold p99");
+
+    /* Timer cost, subtracted from cold samples */
+    uint64_t overhead = UINT64_MAX;
+    for (int i = 0; i < 1000; ++i) {
+        const uint64_t t0 = cycles_begin();
+        const uint64_t t1 = cycles_end();
+        if (t1 - t0 < overhead) overhead = t1 - t0;
+    }
+
+    const phase_query_t* qs = queries;
+    const size_t W = PHASE_WARM_QUERIES;
+    const size_t C = PHASE_COLD_QUERIES;
+    uint64_t* cold = PHASE_HAVE_FLUSH ? samples : NULL;
+    double warm;
+
+#if PHASE_HAVE_FLUSH
+#define PHASE_ROW(label, expr) \
+    do { \
+        PHASE_TIME_WARM(warm, qs, W, expr); \
+        PHASE_TIME_COLD(samples, &m, qs, C, overhead, expr); \
+        print_row(label, warm, cold, C); \
+    } while (0)
+#else
+#define PHASE_ROW(label, expr) \
+    do { \
+        PHASE_TIME_WARM(warm, qs, W, expr); \
+        print_row(label, warm, cold, C); \
+    } while (0)
+#endif
+
+    PHASE_ROW("anchor lookup", phase_anchor(&m, qs[q].key));
+    PHASE_ROW("interpolation", phase_interpolate(&m, qs[q].seg, qs[q].key));
+    PHASE_ROW("window search", phase_window(&m, qs[q].seg, qs[q].lo, qs[q].hi, qs[q].key));
+    PHASE_ROW("anchor + interpolation", phase_interpolate(&m, phase_anchor(&m, qs[q].key), qs[q].key));
+    PHASE_ROW("full model", phase_model(&m, qs[q].key));
+    PHASE_ROW("binary search", phase_binary(&m, qs[q].key));
+#undef PHASE_ROW
+
+    /* The library itself: its table is private, so only warm is comparable */
+    PHASE_TIME_WARM(warm, qs, W, not_stisla_search(arr, n, qs[q].key, table, PHASE_TOL));
+    print_row("not_stisla_search", warm, NULL, 0);
+
+    if (pc->any) {
+        printf("\n");
+        perf_counters_print_header("counters per query");
+        PHASE_COUNT(pc, "binary search", W, phase_binary(&m, qs[q].key));
+        PHASE_COUNT(pc, "anchor lookup", W, phase_anchor(&m, qs[q].key));
+        PHASE_COUNT(pc, "window search", W, phase_window(&m, qs[q].seg, qs[q].lo, qs[q].hi, qs[q].key));
+        PHASE_COUNT(pc, "full model", W, phase_model(&m, qs[q].key));
+        PHASE_COUNT(pc, "not_stisla_search", W, not_stisla_search(arr, n, qs[q].key, table, PHASE_TOL));
+    }
+
+    not_stisla_anchor_table_destroy(table);
+    free(samples);
+    free(queries);
+    free(anchors);
+    free(arr);
+}
+
+int main(void) {
+    printf("🔬 NOT_STISLA Phase Breakdown\n");
+    printf("Version: %s\n", not_stisla_version());
+    printf("Warm: best of %d batches of %d queries. Cold: %d single queries, caches flushed%s.\n", PHASE_WARM_REPS,
+           PHASE_WARM_QUERIES, PHASE_COLD_QUERIES, PHASE_HAVE_FLUSH ? "" : " (unavailable on this target)");
+
+    perf_counters_t pc;
+    perf_counters_open(&pc);
+    if (!pc.any) printf("Hardware counters unavailable (no perf_event_open access; check perf_event_paranoid).\n");
+
+    benchmark_dataset("uniform", generate_uniform, &pc);
+    benchmark_dataset("gapped", generate_gapped, &pc);
+    benchmark_dataset("offsets", generate_offsets, &pc);
+    benchmark_dataset("clustered", generate_clustered, &pc);
+    perf_counters_close(&pc);
+
+    printf("\n✅ Phase breakdown completed\n");
+    return 0;
+}
@@ -0,0 +1,183 @@
+/**
+ * NOT_STISLA Real-Time Benchmark - Per-lookup latency spread
+ *
+ * Times every lookup on its own and reports the latency distribution of the
+ * learning search, the frozen search and the bounded frozen search on each
+ * DSMIL data shape. Jitter is p99 minus median: the bounded search does the
+ * same work for every key, so what remains is cache and timer noise. Each
+ * shape runs once with keys that stay in L2 and once at the full key count,
+ * where DRAM misses set the spread for every search alike.
+ *
+ * Usage: realtime_benchmark [keys] [seed]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/not_stisla.h"
+#include "dsmil_datasets.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <assert.h>
+
+#define REALTIME_DEFAULT_KEYS 1000000
+#define REALTIME_RESIDENT_KEYS 16384  /* 128 KB of keys */
+#define REALTIME_QUERIES 100000
+#define REALTIME_MISS_RATIO 0.1
+#define REALTIME_TOL 8
+#define REALTIME_TIMER_SAMPLES 1000
+
+/* Serialized cycle counter on x86, monotonic nanoseconds elsewhere */
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define REALTIME_UNIT "cycles"
+static inline uint64_t ticks_begin(void) {
+    _mm_lfence();
+    const uint64_t t = __rdtsc();
+    _mm_lfence();
+    return t;
+}
+
+static inline uint64_t ticks_end(void) {
+    unsigned aux;
+    const uint64_t t = __rdtscp(&aux);
+    _mm_lfence();
+    return t;
+}
+#else
+#define REALTIME_UNIT "ns"
+static inline uint64_t ticks_begin(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static inline uint64_t ticks_end(void) {
+    return ticks_begin();
+}
+#endif
+
+static volatile size_t sink;
+
+static int compare_u64(const void* a, const void* b) {
+    const uint64_t x = *(const uint64_t*)a;
+    const uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/* Cost of the timer itself, subtracted from every sample */
+static uint64_t timer_overhead(void) {
+    uint64_t best = UINT64_MAX;
+    for (int i = 0; i < REALTIME_TIMER_SAMPLES; ++i) {
+        const uint64_t t0 = ticks_begin();
+        const uint64_t t1 = ticks_end();
+        if (t1 - t0 < best) best = t1 - t0;
+    }
+    return best;
+}
+
+/* Sorts samples in place */
+static void print_row(const char* name, uint64_t* samples, size_t count, size_t max_probes, size_t errors) {
+    qsort(samples, count, sizeof(uint64_t), compare_u64);
+    const uint64_t p50 = samples[count / 2];
+    const uint64_t p99 = samples[count * 99 / 100];
+    const uint64_t p999 = samples[count * 999 / 1000];
+    char probes[24] = "-";
+    if (max_probes) snprintf(probes, sizeof(probes), "%zu", max_probes);
+    printf("  %-16s %8llu %8llu %8llu %8llu %10llu %8llu %7s %7zu\n", name, (unsigned long long)samples[0],
+           (unsigned long long)p50, (unsigned long long)p99, (unsigned long long)p999,
+           (unsigned long long)samples[count - 1], (unsigned long long)(p99 - p50), probes, errors);
+}
+
+/* q is the loop variable; samples[q] is the lookup's time less the timer */
+#define REALTIME_TIME(samples, queries, overhead, expr)             \
+    for (size_t q = 0; q < REALTIME_QUERIES; ++q) {                  \
+        const uint64_t t0 = ticks_begin();                           \
+        sink = (size_t)(expr);                                       \
+        const uint64_t t1 = ticks_end();                             \
+        const uint64_t dt = t1 - t0;                                 \
+        (samples)[q] = dt > (overhead) ? dt - (overhead) : 0;        \
+    }
+
+static void benchmark_kind(dsmil_data_kind_t kind, const dsmil_data_config_t* cfg, uint64_t overhead) {
+    const size_t n = cfg->n;
+    int64_t* arr = malloc(n * sizeof(int64_t));
+    int64_t* queries = malloc(REALTIME_QUERIES * sizeof(int64_t));
+    uint64_t* samples = malloc(REALTIME_QUERIES * sizeof(uint64_t));
+    assert(arr && queries && samples && "Failed to allocate memory");
+    dsmil_generate(kind, cfg, arr);
+    dsmil_sample_queries(arr, n, queries, REALTIME_QUERIES, REALTIME_MISS_RATIO, cfg->seed + 1);
+
+    /* Learning search from an empty table: inserts and reallocs land in
+     * the timed lookups, as they would in a control loop */
+    not_stisla_anchor_table_t* learning = not_stisla_anchor_table_create();
+    not_stisla_anchor_table_t* built = not_stisla_anchor_table_create();
+    assert(learning && built && "Failed to create anchor table");
+    not_stisla_anchor_table_build(built, arr, n, 0, REALTIME_TOL);
+    not_stisla_frozen_t* frozen = not_stisla_freeze(built, arr, n);
+    assert(frozen && "Failed to freeze table");
+
+    size_t anchors = 0;
+    not_stisla_get_stats(built, NULL, &anchors, NULL);
+    printf("\n%s (%zu keys, %zu anchors, %zu-byte frozen model)\n", dsmil_data_name(kind), n, anchors,
+           not_stisla_frozen_size_bytes(frozen));
+    printf("  %-16s %8s %8s %8s %8s %10s %8s %7s %7s\n", "search", "min", "p50", "p99", "p99.9", "max", "jitter",
+           "bound", "errors");
+
+    REALTIME_TIME(samples, queries, overhead, not_stisla_search(arr, n, queries[q], learning, REALTIME_TOL));
+    print_row("search", samples, REALTIME_QUERIES, 0, 0);
+
+    /* Frozen searches start warm, like a loop that has run for a while */
+    for (size_t q = 0; q < REALTIME_QUERIES; ++q) sink = not_stisla_frozen_search(frozen, arr, queries[q]);
+
+    REALTIME_TIME(samples, queries, overhead, not_stisla_frozen_search(frozen, arr, queries[q]));
+    print_row("frozen", samples, REALTIME_QUERIES, 0, 0);
+
+    /* Untimed pass checks the bounded search against the frozen one */
+    size_t errors = 0;
+    for (size_t q = 0; q < REALTIME_QUERIES; ++q) {
+        errors += not_stisla_frozen_search_bounded(frozen, arr, queries[q]) !=
+                  not_stisla_frozen_search(frozen, arr, queries[q]);
+    }
+
+    REALTIME_TIME(samples, queries, overhead, not_stisla_frozen_search_bounded(frozen, arr, queries[q]));
+    print_row("frozen_bounded", samples, REALTIME_QUERIES, not_stisla_frozen_max_probes(frozen), errors);
+
+    not_stisla_frozen_destroy(frozen);
+    not_stisla_anchor_table_destroy(built);
+    not_stisla_anchor_table_destroy(learning);
+    free(samples);
+    free(queries);
+    free(arr);
+}
+
+int main(int argc, char** argv) {
+    dsmil_data_config_t cfg = { .n = REALTIME_DEFAULT_KEYS, .seed = 42, .skew = 1.0 };
+    if (argc > 1) cfg.n = strtoull(argv[1], NULL, 10);
+    if (argc > 2) cfg.seed = strtoull(argv[2], NULL, 10);
+    if (cfg.n < 2) {
+        fprintf(stderr, "usage: %s [keys >= 2] [seed]\n", argv[0]);
+        return 2;
+    }
+
+    const uint64_t overhead = timer_overhead();
+    printf("⏱️  NOT_STISLA Real-Time Benchmark\n");
+    printf("Version: %s\n", not_stisla_version());
+    printf("%zu keys, %d lookups (%.0f%% misses), %s per lookup less %llu timer overhead\n", cfg.n,
+           REALTIME_QUERIES, REALTIME_MISS_RATIO * 100.0, REALTIME_UNIT, (unsigned long long)overhead);
+    printf("jitter = p99 - p50; bound = worst-case keys read per lookup\n");
+
+    const size_t sizes[2] = { REALTIME_RESIDENT_KEYS, cfg.n };
+    for (int size = 0; size < 2; ++size) {
+        dsmil_data_config_t run = cfg;
+        run.n = sizes[size];
+        printf("\n== %s ==\n", size == 0 ? "Cache-resident keys" : "Full key count");
+        for (int kind = 0; kind < DSMIL_DATA_COUNT; ++kind) {
+            benchmark_kind((dsmil_data_kind_t)kind, &run, overhead);
+        }
+    }
+
+    printf("\n✅ Real-time benchmark completed\n");
+    return 0;
+}
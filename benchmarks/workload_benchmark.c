@@ -0,0 +1,215 @@
+/**
+ * DSMIL Workload Benchmark - Each search wrapper on every workload shape
+ *
+ * Runs not_stisla_search_telemetry/_ids/_offsets/_events on their matching
+ * dataset and on the three mismatched ones, next to binary search and the
+ * generic not_stisla_search, to show what each wrapper's tuning buys. The
+ * IDs wrapper also runs behind a negative-lookup filter built per dataset,
+ * and the keys are searched once more from an Elias-Fano copy, from a
+ * residual-packed copy and from a delta-of-delta copy.
+ *
+ * Usage: workload_benchmark [keys] [skew] [seed] [miss-ratio]
+ */
+
+#include "../include/not_stisla.h"
+#include "dsmil_datasets.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <sys/time.h>
+#include <assert.h>
+
+#define WORKLOAD_DEFAULT_KEYS 1000000
+#define WORKLOAD_QUERIES 200000
+#define WORKLOAD_MISS_RATIO 0.1
+#define WORKLOAD_GENERIC_TOL 8
+#define WORKLOAD_FILTER_BITS 10
+
+static inline uint64_t ns_now(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (uint64_t)tv.tv_sec * 1000000000ULL + (uint64_t)tv.tv_usec * 1000ULL;
+}
+
+typedef not_stisla_result_t (*wrapper_fn)(const int64_t*, size_t, int64_t, not_stisla_anchor_table_t*);
+
+static not_stisla_result_t search_generic(const int64_t* arr, size_t n, int64_t key, not_stisla_anchor_table_t* t) {
+    return not_stisla_search(arr, n, key, t, WORKLOAD_GENERIC_TOL);
+}
+
+/* Filter and compressed copies of the current dataset, rebuilt by benchmark_kind() */
+static not_stisla_filter_t* ids_filter;
+static not_stisla_ef_t* ids_ef;
+static not_stisla_packed_t* ids_packed;
+static not_stisla_dod_t* ts_dod;
+
+static not_stisla_result_t search_ids_filtered(const int64_t* arr, size_t n, int64_t key,
+                                               not_stisla_anchor_table_t* t) {
+    return not_stisla_search_ids_filtered(arr, n, key, t, ids_filter);
+}
+
+/* Positions match arr, so results check against it as usual */
+static not_stisla_result_t search_ef(const int64_t* arr, size_t n, int64_t key, not_stisla_anchor_table_t* t) {
+    (void)arr;
+    (void)n;
+    (void)t;
+    return not_stisla_ef_search(ids_ef, key);
+}
+
+static not_stisla_result_t search_packed(const int64_t* arr, size_t n, int64_t key, not_stisla_anchor_table_t* t) {
+    (void)arr;
+    (void)n;
+    (void)t;
+    return not_stisla_packed_search(ids_packed, key);
+}
+
+static not_stisla_result_t search_dod(const int64_t* arr, size_t n, int64_t key, not_stisla_anchor_table_t* t) {
+    (void)arr;
+    (void)n;
+    (void)t;
+    return not_stisla_dod_search(ts_dod, key);
+}
+
+/* Wrapper i is tuned for dataset kind i; the generic search has no match */
+static const struct {
+    const char* name;
+    wrapper_fn fn;
+    int workload;
+} wrappers[] = {
+    { "search_telemetry", not_stisla_search_telemetry, DSMIL_DATA_TELEMETRY },
+    { "search_ids", not_stisla_search_ids, DSMIL_DATA_IDS },
+    { "search_offsets", not_stisla_search_offsets, DSMIL_DATA_OFFSETS },
+    { "search_events", not_stisla_search_events, DSMIL_DATA_EVENTS },
+    { "search (tol 8)", search_generic, -1 },
+    { "search_ids+filter", search_ids_filtered, DSMIL_DATA_IDS },
+    { "elias-fano", search_ef, DSMIL_DATA_IDS },
+    { "packed", search_packed, DSMIL_DATA_IDS },
+    { "delta-of-delta", search_dod, DSMIL_DATA_TELEMETRY },
+};
+
+static size_t binary_lower(const int64_t* arr, size_t n, int64_t key) {
+    size_t lo = 0, hi = n;
+    while (lo < hi) {
+        const size_t mid = lo + ((hi - lo) >> 1);
+        if (arr[mid] < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/* A result is wrong if it names another key, or misses a present one */
+static bool result_ok(const int64_t* arr, size_t n, int64_t key, not_stisla_result_t r) {
+    if (r != NOT_STISLA_NOT_FOUND) return r < n && arr[r] == key;
+    const size_t i = binary_lower(arr, n, key);
+    return i == n || arr[i] != key;
+}
+
+static void benchmark_kind(dsmil_data_kind_t kind, const dsmil_data_config_t* cfg, double miss_ratio) {
+    const size_t n = cfg->n;
+    int64_t* arr = malloc(n * sizeof(int64_t));
+    int64_t* queries = malloc(WORKLOAD_QUERIES * sizeof(int64_t));
+    assert(arr && queries && "Failed to allocate memory");
+    dsmil_generate(kind, cfg, arr);
+    dsmil_sample_queries(arr, n, queries, WORKLOAD_QUERIES, miss_ratio, cfg->seed + 1);
+    ids_filter = not_stisla_filter_build(arr, n, WORKLOAD_FILTER_BITS);
+    assert(ids_filter && "Failed to build filter");
+    ids_ef = not_stisla_ef_build(arr, n);
+    assert(ids_ef && "Failed to build Elias-Fano set");
+    ids_packed = not_stisla_packed_build(arr, n, 0);
+    assert(ids_packed && "Failed to build packed array");
+    ts_dod = not_stisla_dod_build(arr, n, 0);
+    assert(ts_dod && "Failed to build delta-of-delta column");
+
+    uint64_t start = ns_now();
+    size_t found = 0;
+    for (size_t q = 0; q < WORKLOAD_QUERIES; ++q) {
+        const size_t i = binary_lower(arr, n, queries[q]);
+        found += (i < n && arr[i] == queries[q]);
+    }
+    const double bin_ns = (double)(ns_now() - start) / WORKLOAD_QUERIES;
+
+    printf("\n%s (%zu keys, %lld..%lld, %zu of %d queries hit)\n", dsmil_data_name(kind), n, (long long)arr[0],
+           (long long)arr[n - 1], found, WORKLOAD_QUERIES);
+    printf("  %zu-byte filter; bits/key: Elias-Fano %.1f, packed %.1f, delta-of-delta %.1f\n",
+           not_stisla_filter_size_bytes(ids_filter), 8.0 * (double)not_stisla_ef_size_bytes(ids_ef) / (double)n,
+           8.0 * (double)not_stisla_packed_size_bytes(ids_packed) / (double)n,
+           8.0 * (double)not_stisla_dod_size_bytes(ts_dod) / (double)n);
+    printf("  %-18s %10s %10s %10s %8s %8s %7s\n", "search", "learn ns", "ns/op", "window", "escal", "anchors",
+           "errors");
+    printf("  %-18s %10s %10.1f %10s %8s %8s %7s\n", "binary search", "-", bin_ns, "-", "-", "-", "-");
+
+    for (size_t w = 0; w < sizeof(wrappers) / sizeof(wrappers[0]); ++w) {
+        not_stisla_anchor_table_t* t = not_stisla_anchor_table_create();
+        assert(t && "Failed to create anchor table");
+        if (wrappers[w].workload >= 0) not_stisla_init_for_dsmil(t, wrappers[w].workload);
+
+        /* First pass learns the table, second pass runs on what it learned */
+        start = ns_now();
+        for (size_t q = 0; q < WORKLOAD_QUERIES; ++q) wrappers[w].fn(arr, n, queries[q], t);
+        const double learn_ns = (double)(ns_now() - start) / WORKLOAD_QUERIES;
+
+        not_stisla_search_stats_t before;
+        not_stisla_get_search_stats(t, &before);
+
+        start = ns_now();
+        for (size_t q = 0; q < WORKLOAD_QUERIES; ++q) wrappers[w].fn(arr, n, queries[q], t);
+        const double ns = (double)(ns_now() - start) / WORKLOAD_QUERIES;
+
+        not_stisla_search_stats_t after;
+        not_stisla_get_search_stats(t, &after);
+        const size_t lookups = after.lookups - before.lookups;
+        size_t anchors = 0;
+        not_stisla_get_stats(t, NULL, &anchors, NULL);
+
+        /* Untimed third pass checks every answer */
+        size_t errors = 0;
+        for (size_t q = 0; q < WORKLOAD_QUERIES; ++q) {
+            errors += !result_ok(arr, n, queries[q], wrappers[w].fn(arr, n, queries[q], t));
+        }
+
+        printf("%c %-18s %10.1f %10.1f %10.1f %8zu %8zu %7zu\n", wrappers[w].workload == (int)kind ? '*' : ' ',
+               wrappers[w].name, learn_ns, ns,
+               lookups ? (double)(after.window_keys - before.window_keys) / lookups : 0.0,
+               after.escalations - before.escalations, anchors, errors);
+        not_stisla_anchor_table_destroy(t);
+    }
+
+    not_stisla_filter_destroy(ids_filter);
+    ids_filter = NULL;
+    not_stisla_ef_destroy(ids_ef);
+    ids_ef = NULL;
+    not_stisla_packed_destroy(ids_packed);
+    ids_packed = NULL;
+    not_stisla_dod_destroy(ts_dod);
+    ts_dod = NULL;
+    free(queries);
+    free(arr);
+}
+
+int main(int argc, char** argv) {
+    dsmil_data_config_t cfg = { .n = WORKLOAD_DEFAULT_KEYS, .seed = 42, .skew = 1.0 };
+    if (argc > 1) cfg.n = strtoull(argv[1], NULL, 10);
+    if (argc > 2) cfg.skew = strtod(argv[2], NULL);
+    if (argc > 3) cfg.seed = strtoull(argv[3], NULL, 10);
+    const double miss_ratio = (argc > 4) ? strtod(argv[4], NULL) : WORKLOAD_MISS_RATIO;
+    if (cfg.n < 2) {
+        fprintf(stderr, "usage: %s [keys >= 2] [skew] [seed] [miss-ratio]\n", argv[0]);
+        return 2;
+    }
+
+    printf("🎯 DSMIL Workload Benchmark\n");
+    printf("Version: %s\n", not_stisla_version());
+    printf("%zu keys, skew %.2f, seed %llu, %d queries (%.0f%% misses); * = wrapper tuned for this data\n", cfg.n,
+           cfg.skew, (unsigned long long)cfg.seed, WORKLOAD_QUERIES, miss_ratio * 100.0);
+
+    for (int kind = 0; kind < DSMIL_DATA_COUNT; ++kind) {
+        benchmark_kind((dsmil_data_kind_t)kind, &cfg, miss_ratio);
+    }
+
+    printf("\n✅ Workload benchmark completed\n");
+    return 0;
+}
@@ -24,27 +24,184 @@ extern "C" {
 /**
  * NOT_STISLA Anchor Table - Learns optimal interpolation points
  */
-typedef struct not_stisla_anchor_table not_not_stisla_anchor_table_t;
+typedef struct not_stisla_anchor_table not_stisla_anchor_table_t;
+
+/**
+ * NOT_STISLA Live Index - Anchor model rebuilt in the background and swapped atomically
+ */
+typedef struct not_stisla_live not_stisla_live_t;
+
+/**
+ * NOT_STISLA Frozen Table - Immutable compiled model, read-only search path
+ */
+typedef struct not_stisla_frozen not_stisla_frozen_t;
+
+/**
+ * NOT_STISLA Spline - RadixSpline index with error-bounded linear segments
+ */
+typedef struct not_stisla_spline not_stisla_spline_t;
+
+/**
+ * NOT_STISLA Append - Sorted array appended by one writer while others search
+ */
+typedef struct not_stisla_append not_stisla_append_t;
+
+/**
+ * NOT_STISLA Shared Table - Learned anchors in memory shared between processes
+ */
+typedef struct not_stisla_shared not_stisla_shared_t;
+
+/**
+ * NOT_STISLA Filter - Blocked Bloom filter rejecting absent keys before a search
+ */
+typedef struct not_stisla_filter not_stisla_filter_t;
+
+/**
+ * NOT_STISLA Elias-Fano - Compressed sorted key set searched without decoding
+ */
+typedef struct not_stisla_ef not_stisla_ef_t;
+
+/**
+ * NOT_STISLA Packed - Sorted keys stored as bit-packed residuals against per-block lines
+ */
+typedef struct not_stisla_packed not_stisla_packed_t;
+
+/**
+ * NOT_STISLA Delta-of-Delta - Compressed timestamp column decoded one block per lookup
+ */
+typedef struct not_stisla_dod not_stisla_dod_t;
+
+/**
+ * NOT_STISLA Pool - Memory budget shared by a group of anchor tables
+ */
+typedef struct not_stisla_pool not_stisla_pool_t;
 
 /**
  * Search result indicating index or not found
  */
-typedef size_t not_not_stisla_result_t;
-#define NOT_STISLA_NOT_FOUND ((not_not_stisla_result_t)-1)
+typedef size_t not_stisla_result_t;
+#define NOT_STISLA_NOT_FOUND ((not_stisla_result_t)-1)
+
+/**
+ * Detailed search statistics for tuning window sizes
+ */
+typedef struct {
+    size_t searches;          /* Searches that found their key */
+    size_t lookups;           /* Model searches, found or not */
+    size_t escalations;       /* Lookups that missed their first window */
+    size_t window_keys;       /* Sum of first window sizes (keys) */
+    size_t anchors;           /* Anchors currently in the table */
+    size_t bounded_segments;  /* Segments with exact measured error bounds */
+    size_t curved_segments;   /* Segments predicting with three-point interpolation */
+    size_t exact_segments;    /* Arithmetic-progression segments searched by direct address */
+} not_stisla_search_stats_t;
+
+/**
+ * Interpolation used between anchors
+ */
+typedef enum {
+    NOT_STISLA_INTERP_LINEAR = 0,       /* Straight line between the two bounding anchors */
+    NOT_STISLA_INTERP_THREE_POINT = 1,  /* Curve through both anchors and the segment midpoint */
+    NOT_STISLA_INTERP_AUTO = 2          /* Per segment: three-point only where linear error is high */
+} not_stisla_interp_mode_t;
+
+/**
+ * Monotone key transforms applied before linear interpolation
+ */
+typedef enum {
+    NOT_STISLA_TRANSFORM_NONE = 0,      /* Interpolate raw keys */
+    NOT_STISLA_TRANSFORM_LOG = 1,       /* log(1 + key - min): exponential spacing becomes linear */
+    NOT_STISLA_TRANSFORM_SQRT = 2,      /* sqrt(key - min): quadratic spacing becomes linear */
+    NOT_STISLA_TRANSFORM_PIECEWISE = 3  /* Learned piecewise-linear approximation of the key CDF */
+} not_stisla_transform_kind_t;
+
+/**
+ * Aggregated memory accounting of one pool
+ */
+typedef struct {
+    size_t budget_bytes;    /* Limit, 0 = unlimited */
+    size_t used_bytes;      /* Tables and anchor arrays currently charged */
+    size_t peak_bytes;      /* Highest used_bytes seen */
+    size_t tables;          /* Tables charged to the pool */
+    size_t denied_growths;  /* Anchor growths refused by the budget */
+    size_t downgrades;      /* Creates, builds and seeds given fewer anchors than asked */
+} not_stisla_pool_stats_t;
 
 /**
  * @brief Create a new Competitor anchor table
  *
  * @return Pointer to new anchor table, or NULL on allocation failure
  */
-not_stisla_anchor_table_t* stisla_anchor_table_create(void);
+not_stisla_anchor_table_t* not_stisla_anchor_table_create(void);
 
 /**
  * @brief Destroy an Competitor anchor table
  *
  * @param table The anchor table to destroy
  */
-void stisla_anchor_table_destroy(not_stisla_anchor_table_t* table);
+void not_stisla_anchor_table_destroy(not_stisla_anchor_table_t* table);
+
+/**
+ * @brief Create an anchor table whose memory is charged to a pool
+ *
+ * Tables consult their pool before every growth. Over budget a learning
+ * table keeps the anchors it has, and builds and seeds get the largest
+ * anchor count that fits (down to the two endpoints) instead of failing.
+ *
+ * @param pool Pool to charge (NULL = the process-wide default pool)
+ * @return     New anchor table, or NULL if not even two anchors fit
+ */
+not_stisla_anchor_table_t* not_stisla_anchor_table_create_in(not_stisla_pool_t* pool);
+
+/**
+ * @brief Release the table's unused anchor capacity back to its pool
+ *
+ * @param table The anchor table
+ * @return      Bytes released
+ */
+size_t not_stisla_anchor_table_trim(not_stisla_anchor_table_t* table);
+
+/**
+ * @brief Create a memory pool for anchor tables
+ *
+ * Every table created with not_stisla_anchor_table_create() is charged to
+ * the default pool; not_stisla_anchor_table_create_in() picks another one.
+ * Destroy a pool only after all of its tables.
+ *
+ * @param budget_bytes Limit on the pool's table memory (0 = unlimited)
+ * @return             New pool, or NULL on allocation failure
+ */
+not_stisla_pool_t* not_stisla_pool_create(size_t budget_bytes);
+
+/**
+ * @brief Free a pool created by not_stisla_pool_create()
+ *
+ * @param pool The pool to destroy (the default pool is never freed)
+ */
+void not_stisla_pool_destroy(not_stisla_pool_t* pool);
+
+/**
+ * @brief The process-wide pool, unlimited until given a budget
+ *
+ * @return Default pool
+ */
+not_stisla_pool_t* not_stisla_pool_default(void);
+
+/**
+ * @brief Change a pool's budget; tables already past it stop growing
+ *
+ * @param pool         Pool (NULL = the default pool)
+ * @param budget_bytes New limit (0 = unlimited)
+ */
+void not_stisla_pool_set_budget(not_stisla_pool_t* pool, size_t budget_bytes);
+
+/**
+ * @brief Get a pool's aggregated memory accounting
+ *
+ * @param pool  Pool (NULL = the default pool)
+ * @param stats Output statistics
+ */
+void not_stisla_pool_get_stats(const not_stisla_pool_t* pool, not_stisla_pool_stats_t* stats);
 
 /**
  * @brief Get the number of anchors in the table
@@ -52,14 +209,36 @@ void stisla_anchor_table_destroy(not_stisla_anchor_table_t* table);
  * @param table The anchor table
  * @return Number of anchors currently learned
  */
-size_t stisla_anchor_table_size(const not_stisla_anchor_table_t* table);
+size_t not_stisla_anchor_table_size(const not_stisla_anchor_table_t* table);
 
 /**
  * @brief Reset anchor table (clear all learned anchors)
  *
  * @param table The anchor table to reset
  */
-void stisla_anchor_table_reset(not_stisla_anchor_table_t* table);
+void not_stisla_anchor_table_reset(not_stisla_anchor_table_t* table);
+
+/**
+ * @brief Build an optimized anchor set for an array in one offline pass
+ *
+ * Replaces the table's anchors by greedily splitting the segment with the
+ * worst prediction error until every key is predicted within 'tol' or the
+ * anchor budget is spent. Learning continues on top of the built set.
+ *
+ * @param table       The anchor table to (re)build
+ * @param arr         Pointer to sorted array of int64_t values
+ * @param n           Number of elements in array (at least 2)
+ * @param max_anchors Anchor budget (0 selects the library default)
+ * @param tol         Target prediction tolerance
+ * @return            true on success, false on invalid input or allocation failure
+ */
+bool not_stisla_anchor_table_build(
+    not_stisla_anchor_table_t* table,
+    const int64_t* arr,
+    size_t n,
+    size_t max_anchors,
+    size_t tol
+);
 
 /**
  * @brief Ultra-optimized Competitor search
@@ -74,9 +253,9 @@ void stisla_anchor_table_reset(not_stisla_anchor_table_t* table);
  * @param key    Value to search for
  * @param table  Anchor table for learning (can be NULL for one-off searches)
  * @param tol    Prediction tolerance (recommended: 8-16)
- * @return       Index of found element, or Competitor_NOT_FOUND
+ * @return       Index of found element, or NOT_STISLA_NOT_FOUND
  */
-not_stisla_result_t stisla_search(
+not_stisla_result_t not_stisla_search(
     const int64_t* arr,
     size_t n,
     int64_t key,
@@ -98,7 +277,7 @@ not_stisla_result_t stisla_search(
  * @param tol     Prediction tolerance
  * @return        Number of keys found
  */
-size_t stisla_batch_search(
+size_t not_stisla_batch_search(
     const int64_t* arr,
     size_t n,
     const int64_t* keys,
@@ -108,21 +287,128 @@ size_t stisla_batch_search(
     size_t tol
 );
 
+/**
+ * @brief Seed a table with anchors before its first search
+ *
+ * Avoids the cold start of a fresh table, which only knows the array
+ * endpoints. Starting from the endpoints, the segment whose prediction is
+ * worst at its quarter ranks is split at that rank, until every probe is
+ * within 'tol' or the budget is spent. Each split reads O(1) keys, so seeding
+ * costs O(max_anchors^2) regardless of n. Seeded segments are unmeasured
+ * and keep learning like learned ones.
+ *
+ * @param table       The anchor table to seed
+ * @param arr         Pointer to sorted array of int64_t values
+ * @param n           Number of elements in array (at least 2)
+ * @param max_anchors Anchor budget (0 selects the workload learning budget)
+ * @param tol         Target prediction tolerance
+ * @return            true on success, false on invalid input or allocation failure
+ */
+bool not_stisla_anchor_table_seed(
+    not_stisla_anchor_table_t* table,
+    const int64_t* arr,
+    size_t n,
+    size_t max_anchors,
+    size_t tol
+);
+
 /**
  * @brief Get performance statistics
  *
  * @param table Anchor table
  * @param searches_total Total searches performed
  * @param anchors_learned Number of anchors learned
- * @param memory_used_bytes Memory usage in bytes
+ * @param memory_used_bytes Memory usage in bytes: the table, its anchor slots
+ *                          and their lookup keys
  */
-void stisla_get_stats(
+void not_stisla_get_stats(
     const not_stisla_anchor_table_t* table,
     size_t* searches_total,
     size_t* anchors_learned,
     size_t* memory_used_bytes
 );
 
+/**
+ * @brief Get per-window statistics
+ *
+ * Each segment between anchors sizes its window from its own error bound:
+ * segments measured by not_stisla_anchor_table_build() use their exact
+ * bound, learned segments use the largest error observed so far but never
+ * less than the tolerance.
+ *
+ * @param table Anchor table
+ * @param stats Output statistics
+ */
+void not_stisla_get_search_stats(
+    const not_stisla_anchor_table_t* table,
+    not_stisla_search_stats_t* stats
+);
+
+/**
+ * @brief Select the interpolation mode of a table
+ *
+ * Three-point mode fits a TIP-style curve through each segment's anchors and
+ * its midpoint key, which follows exponentially growing keys far better than
+ * a straight line. Auto mode bends a learned segment when, at its quarter
+ * ranks, the curve errs by under half the line's error; built tables pick
+ * the mode with the smaller measured error per segment. Existing segments
+ * restart unmeasured (auto ones choose on their next search), so call this
+ * before not_stisla_anchor_table_build().
+ *
+ * @param table Anchor table
+ * @param mode  Interpolation mode
+ * @return      true on success, false on invalid table or mode
+ */
+bool not_stisla_set_interpolation(
+    not_stisla_anchor_table_t* table,
+    not_stisla_interp_mode_t mode
+);
+
+/**
+ * @brief Select a key transform and fit its parameters from a sample
+ *
+ * Linear segments interpolate transformed keys, so exponentially or
+ * quadratically spaced keys become near-linear and windows shrink.
+ * Curved (three-point) segments are unaffected. Segment bounds restart
+ * unmeasured.
+ *
+ * @param table Anchor table
+ * @param kind  Transform to use
+ * @param arr   Sorted array to fit from (may be NULL except for the piecewise transform,
+ *              log/sqrt then start at the first key seen by the next search)
+ * @param n     Number of elements in array
+ * @return      true on success, false on invalid arguments
+ */
+bool not_stisla_set_transform(
+    not_stisla_anchor_table_t* table,
+    not_stisla_transform_kind_t kind,
+    const int64_t* arr,
+    size_t n
+);
+
+/**
+ * @brief Pick the transform that best linearizes a sample of the array
+ *
+ * Scores each transform by how straight it makes the keys at several anchor
+ * spacings: the array is cut into 1, 8 and 64 equal-rank segments, 256
+ * rank-spaced sample keys are predicted from the transformed endpoints of
+ * their segment, and the mean rank error relative to segment length is
+ * summed over the three cuts. Log and sqrt are scored at their default
+ * origin and at offsets 2^0..2^62, keeping the best. The transform with the
+ * lowest score is applied; the learned piecewise one has its score doubled
+ * first, since it costs a knot search per query.
+ *
+ * @param table Anchor table
+ * @param arr   Sorted array to fit from
+ * @param n     Number of elements in array
+ * @return      The transform applied
+ */
+not_stisla_transform_kind_t not_stisla_fit_transform(
+    not_stisla_anchor_table_t* table,
+    const int64_t* arr,
+    size_t n
+);
+
 /**
  * @brief DSMIL-specific search for telemetry timestamps
  *
@@ -132,9 +418,9 @@ void stisla_get_stats(
  * @param n Number of timestamps
  * @param target_time Time to search for
  * @param table Anchor table (persistent across calls)
- * @return Index of timestamp, or Competitor_NOT_FOUND
+ * @return Index of timestamp, or NOT_STISLA_NOT_FOUND
  */
-not_stisla_result_t stisla_search_telemetry(
+not_stisla_result_t not_stisla_search_telemetry(
     const int64_t* timestamps,
     size_t n,
     int64_t target_time,
@@ -150,9 +436,9 @@ not_stisla_result_t stisla_search_telemetry(
  * @param n Number of IDs
  * @param target_id ID to search for
  * @param table Anchor table (persistent across calls)
- * @return Index of ID, or Competitor_NOT_FOUND
+ * @return Index of ID, or NOT_STISLA_NOT_FOUND
  */
-not_stisla_result_t stisla_search_ids(
+not_stisla_result_t not_stisla_search_ids(
     const int64_t* ids,
     size_t n,
     int64_t target_id,
@@ -168,9 +454,9 @@ not_stisla_result_t stisla_search_ids(
  * @param n Number of offsets
  * @param target_offset Offset to search for
  * @param table Anchor table (persistent across calls)
- * @return Index of offset, or Competitor_NOT_FOUND
+ * @return Index of offset, or NOT_STISLA_NOT_FOUND
  */
-not_stisla_result_t stisla_search_offsets(
+not_stisla_result_t not_stisla_search_offsets(
     const int64_t* offsets,
     size_t n,
     int64_t target_offset,
@@ -186,9 +472,9 @@ not_stisla_result_t stisla_search_offsets(
  * @param n Number of events
  * @param target_time Event time to search for
  * @param table Anchor table (persistent across calls)
- * @return Index of event, or Competitor_NOT_FOUND
+ * @return Index of event, or NOT_STISLA_NOT_FOUND
  */
-not_stisla_result_t stisla_search_events(
+not_stisla_result_t not_stisla_search_events(
     const int64_t* events,
     size_t n,
     int64_t target_time,
@@ -199,16 +485,853 @@ not_stisla_result_t stisla_search_events(
  * @brief Initialize Competitor for DSMIL workloads
  *
  * Pre-configures anchor table with DSMIL-specific parameters.
+ * The offsets workload selects the log transform.
  *
  * @param table Anchor table to initialize
  * @param workload_type Type of DSMIL workload (0=telemetry, 1=ids, 2=offsets, 3=events)
  * @return true on success
  */
-bool stisla_init_for_dsmil(
+bool not_stisla_init_for_dsmil(
     not_stisla_anchor_table_t* table,
     int workload_type
 );
 
+/**
+ * @brief Create a live index over a sorted array
+ *
+ * The first model is built synchronously, so no query sees a cold start.
+ * Later models are built on a background thread and swapped in atomically
+ * while readers continue on the previous one.
+ *
+ * @param arr         Pointer to sorted array of int64_t values
+ * @param n           Number of elements in array
+ * @param tol         Prediction tolerance used by searches and builds
+ * @param max_anchors Anchor budget per build (0 selects the library default)
+ * @return            New live index, or NULL on failure
+ */
+not_stisla_live_t* not_stisla_live_create(
+    const int64_t* arr,
+    size_t n,
+    size_t tol,
+    size_t max_anchors
+);
+
+/**
+ * @brief Stop the rebuild thread and free the live index
+ *
+ * @param live The live index to destroy
+ */
+void not_stisla_live_destroy(not_stisla_live_t* live);
+
+/**
+ * @brief Search the current model of a live index
+ *
+ * Safe to call from any number of threads concurrently. Never blocks and
+ * never learns; the model is only replaced by the rebuild thread.
+ *
+ * @param live Live index
+ * @param key  Value to search for
+ * @return     Index of found element, or NOT_STISLA_NOT_FOUND
+ */
+not_stisla_result_t not_stisla_live_search(not_stisla_live_t* live, int64_t key);
+
+/**
+ * @brief Request a background rebuild, optionally over a new array
+ *
+ * The caller must keep the previous array alive until not_stisla_live_wait()
+ * returns true, since readers may still be searching it. If the build fails
+ * the previous model and array stay in service.
+ *
+ * @param live Live index
+ * @param arr  Sorted array the next model is built for
+ * @param n    Number of elements in array
+ * @return     true if the request was queued
+ */
+bool not_stisla_live_rebuild(not_stisla_live_t* live, const int64_t* arr, size_t n);
+
+/**
+ * @brief Trigger rebuilds automatically when the sampled error grows
+ *
+ * A rebuild fires when sampled queries see more error than the model had
+ * when it was built. It is only swapped in if it predicts the current keys
+ * better. Otherwise the model is kept and the sample count needed before
+ * the next attempt doubles, up to 2^16 times min_samples. A published
+ * model or a new threshold resets the count.
+ *
+ * @param live        Live index
+ * @param mean_error  Mean prediction error (in elements) that triggers a rebuild, 0 disables
+ * @param min_samples Sampled queries required before the threshold is evaluated
+ */
+void not_stisla_live_set_rebuild_threshold(not_stisla_live_t* live, size_t mean_error, size_t min_samples);
+
+/**
+ * @brief Wait until all requested rebuilds have finished
+ *
+ * @param live Live index
+ * @return     true if the latest requested model was published; false if its
+ *             build failed (the previous array is still searched and must
+ *             stay alive) or live is NULL
+ */
+bool not_stisla_live_wait(not_stisla_live_t* live);
+
+/**
+ * @brief Number of models published since creation
+ *
+ * @param live Live index
+ * @return     Generation of the model currently served
+ */
+size_t not_stisla_live_generation(not_stisla_live_t* live);
+
+/**
+ * @brief Compile a learned table into an immutable frozen model
+ *
+ * The frozen model stores anchors as flat arrays with exact per-segment error
+ * bounds measured over every key of 'arr'. Each segment keeps the predictor
+ * the table uses for it: the direct address of an arithmetic progression,
+ * the three-point curve of a curved segment, the table's key transform, or
+ * a precomputed slope, so a frozen model predicts as well as its table.
+ * It is a single position-independent block of not_stisla_frozen_size_bytes()
+ * bytes that may be copied into shared memory or a file and searched in place.
+ * Anchor indices are stored in 32 bits when n <= 2^32, and anchor keys as
+ * 32-bit offsets from the first key when the anchors span less than 2^32.
+ * The source table is not modified and may keep learning.
+ *
+ * @param table Learned anchor table (NULL freezes the two endpoints only)
+ * @param arr   Sorted array the table was learned on
+ * @param n     Number of elements in array (at least 2)
+ * @return      New frozen model, or NULL on failure
+ */
+not_stisla_frozen_t* not_stisla_freeze(
+    const not_stisla_anchor_table_t* table,
+    const int64_t* arr,
+    size_t n
+);
+
+/**
+ * @brief Free a frozen model created by not_stisla_freeze()
+ *
+ * @param frozen The frozen model to destroy
+ */
+void not_stisla_frozen_destroy(not_stisla_frozen_t* frozen);
+
+/**
+ * @brief Size of the frozen model block in bytes
+ *
+ * @param frozen Frozen model
+ * @return       Bytes to copy when sharing the model
+ */
+size_t not_stisla_frozen_size_bytes(const not_stisla_frozen_t* frozen);
+
+/**
+ * @brief Validate a copied frozen block and use it in place
+ *
+ * Checks every array offset and length against the block, the anchor
+ * indices against the stored length (first 0, last n - 1, increasing), and
+ * each segment's predictor and error window, in O(anchors). A truncated or
+ * corrupt block is rejected rather than read out of bounds. Search it only
+ * with an array of the stored length.
+ *
+ * @param data Start of the block (8-byte aligned)
+ * @param len  Bytes available at data
+ * @return     Frozen model view, or NULL if the block is invalid
+ */
+const not_stisla_frozen_t* not_stisla_frozen_attach(const void* data, size_t len);
+
+/**
+ * @brief Strictly read-only search over a frozen model
+ *
+ * Never writes to the model, so any number of threads or processes may share
+ * it without locking. Every present key is found inside its segment's error
+ * window without escalation.
+ *
+ * @param frozen Frozen model
+ * @param arr    Sorted array the model was frozen for
+ * @param key    Value to search for
+ * @return       Index of found element, or NOT_STISLA_NOT_FOUND
+ */
+not_stisla_result_t not_stisla_frozen_search(
+    const not_stisla_frozen_t* frozen,
+    const int64_t* arr,
+    int64_t key
+);
+
+/**
+ * @brief Bounded-latency search over a frozen model, for real-time callers
+ *
+ * Same answers as not_stisla_frozen_search(), but the window search always
+ * runs the model's fixed number of branch-free halving steps, so the work
+ * per lookup does not depend on the key. Never allocates, locks, learns or
+ * escalates; a lookup reads at most not_stisla_frozen_max_probes() keys.
+ *
+ * @param frozen Frozen model
+ * @param arr    Sorted array the model was frozen for
+ * @param key    Value to search for
+ * @return       Index of found element, or NOT_STISLA_NOT_FOUND
+ */
+not_stisla_result_t not_stisla_frozen_search_bounded(
+    const not_stisla_frozen_t* frozen,
+    const int64_t* arr,
+    int64_t key
+);
+
+/**
+ * @brief Worst-case key reads of one not_stisla_frozen_search_bounded() call
+ *
+ * Anchor lookup reads plus ceil(log2(widest window)) window halvings plus
+ * two final compares. Build the table with not_stisla_anchor_table_build()
+ * before freezing to keep the windows, and so the bound, small.
+ *
+ * @param frozen Frozen model
+ * @return       Upper bound on keys read per lookup, 0 if frozen is NULL
+ */
+size_t not_stisla_frozen_max_probes(const not_stisla_frozen_t* frozen);
+
+/**
+ * @brief Build a RadixSpline over a sorted array in a single pass
+ *
+ * A greedy spline corridor places knots so that every key's first position is
+ * predicted within max_error. A radix table over the top radix_bits of
+ * (key - min) maps each key straight to a handful of candidate knots, so a
+ * lookup costs a radix slot, a spline segment and one bounded data window.
+ *
+ * @param arr        Sorted array to index
+ * @param n          Number of elements
+ * @param max_error  Maximum prediction error in positions (0 = default 32)
+ * @param radix_bits Radix table bits (0 = sized to the knot count, up to 18; max 30)
+ * @return           New spline, or NULL on failure
+ */
+not_stisla_spline_t* not_stisla_spline_build(
+    const int64_t* arr,
+    size_t n,
+    size_t max_error,
+    unsigned radix_bits
+);
+
+/**
+ * @brief Build a RadixSpline using several threads
+ *
+ * The array is split into chunks that start at the first occurrence of a
+ * key; each chunk is fitted on its own thread and the knots are concatenated.
+ * The joining segments contain no interior keys, so every key is still
+ * predicted within max_error. Produces at most two extra knots per chunk.
+ *
+ * @param arr        Sorted array to index
+ * @param n          Number of elements
+ * @param max_error  Maximum prediction error in positions (0 = default 32)
+ * @param radix_bits Radix table bits (0 = sized to the knot count)
+ * @param threads    Build threads (0 = online CPUs); capped so each gets 64K keys
+ * @return           New spline, or NULL on failure
+ */
+not_stisla_spline_t* not_stisla_spline_build_parallel(
+    const int64_t* arr,
+    size_t n,
+    size_t max_error,
+    unsigned radix_bits,
+    size_t threads
+);
+
+/**
+ * @brief Free a spline created by not_stisla_spline_build()
+ *
+ * @param spline The spline to destroy
+ */
+void not_stisla_spline_destroy(not_stisla_spline_t* spline);
+
+/**
+ * @brief Search a sorted array through its spline
+ *
+ * Read-only; safe to share between threads.
+ *
+ * @param spline Spline built for arr
+ * @param arr    Sorted array the spline was built for
+ * @param key    Value to search for
+ * @return       Index of first occurrence, or NOT_STISLA_NOT_FOUND
+ */
+not_stisla_result_t not_stisla_spline_search(
+    const not_stisla_spline_t* spline,
+    const int64_t* arr,
+    int64_t key
+);
+
+/**
+ * @brief Position of the first element >= key
+ *
+ * @param spline Spline built for arr
+ * @param arr    Sorted array the spline was built for
+ * @param key    Value to locate
+ * @return       Lower bound position in [0, n]
+ */
+size_t not_stisla_spline_lower_bound(
+    const not_stisla_spline_t* spline,
+    const int64_t* arr,
+    int64_t key
+);
+
+/**
+ * @brief Get spline statistics
+ *
+ * @param spline            Spline to query
+ * @param points            Output: number of spline knots (can be NULL)
+ * @param memory_used_bytes Output: knots plus radix table (can be NULL)
+ * @param max_error         Output: prediction error bound in positions; a
+ *                          lookup's first window is 2 * max_error + 1 keys (can be NULL)
+ */
+void not_stisla_spline_get_stats(
+    const not_stisla_spline_t* spline,
+    size_t* points,
+    size_t* memory_used_bytes,
+    size_t* max_error
+);
+
+/**
+ * @brief Sort int64 keys with a parallel LSD radix sort
+ *
+ * Stable, 8 bits per pass; passes over digits shared by every key are
+ * skipped. Needs n extra keys of scratch space (and n extra indices when a
+ * permutation is requested).
+ *
+ * @param keys    Keys to sort in place
+ * @param n       Number of keys
+ * @param perm    Output: perm[i] = original position of keys[i], for
+ *                reordering payloads (can be NULL)
+ * @param threads Sort threads (0 = online CPUs); capped so each gets 64K keys
+ * @return        true on success, false on invalid input or allocation failure
+ */
+bool not_stisla_radix_sort(
+    int64_t* keys,
+    size_t n,
+    size_t* perm,
+    size_t threads
+);
+
+/**
+ * @brief Sort unsorted keys and build their spline in one pipeline
+ *
+ * Runs not_stisla_radix_sort() and then, on the same threads and without
+ * another round of thread startup, fits each thread's chunk of the sorted
+ * output. The result is identical to not_stisla_spline_build_parallel() on
+ * the sorted keys.
+ *
+ * @param keys      Keys to sort in place; the spline indexes the sorted array
+ * @param n         Number of keys
+ * @param perm      Output permutation as for not_stisla_radix_sort() (can be NULL)
+ * @param max_error Maximum prediction error in positions (0 = default 32)
+ * @param threads   Threads (0 = online CPUs)
+ * @return          Spline over the sorted keys, or NULL on failure
+ */
+not_stisla_spline_t* not_stisla_ingest(
+    int64_t* keys,
+    size_t n,
+    size_t* perm,
+    size_t max_error,
+    size_t threads
+);
+
+/**
+ * @brief Create an appendable sorted array for one writer and many readers
+ *
+ * The writer extends a spline model as keys arrive and publishes the new
+ * length and tail segment under a sequence lock. Storage is reserved up
+ * front and never moves, so readers need no locks and never block.
+ *
+ * @param capacity  Maximum number of keys
+ * @param max_error Maximum prediction error in positions (0 = default 32)
+ * @return          New array, or NULL on failure
+ */
+not_stisla_append_t* not_stisla_append_create(size_t capacity, size_t max_error);
+
+/**
+ * @brief Free an appendable array
+ *
+ * No reader may still be searching it.
+ *
+ * @param app The array to destroy
+ */
+void not_stisla_append_destroy(not_stisla_append_t* app);
+
+/**
+ * @brief Append keys and publish them (writer thread only)
+ *
+ * Keys must not be smaller than the current last key. Appending stops at
+ * the first out-of-order key, at capacity, or on allocation failure; the
+ * keys appended so far are published in one step.
+ *
+ * @param app   Appendable array
+ * @param keys  Keys to append, in non-decreasing order
+ * @param count Number of keys
+ * @return      Number of keys appended and published
+ */
+size_t not_stisla_append(
+    not_stisla_append_t* app,
+    const int64_t* keys,
+    size_t count
+);
+
+/**
+ * @brief Search the published keys (any thread)
+ *
+ * Takes a consistent snapshot of length and tail model, retrying only if
+ * it raced with a publish, then searches one bounded window.
+ *
+ * @param app Appendable array
+ * @param key Value to search for
+ * @return    Index of first occurrence, or NOT_STISLA_NOT_FOUND
+ */
+not_stisla_result_t not_stisla_append_search(not_stisla_append_t* app, int64_t key);
+
+/**
+ * @brief Number of published keys
+ *
+ * @param app Appendable array
+ * @return    Published length; keys [0, length) of the data never change
+ */
+size_t not_stisla_append_length(const not_stisla_append_t* app);
+
+/**
+ * @brief Published keys, valid for not_stisla_append_length() entries
+ *
+ * @param app Appendable array
+ * @return    Key storage
+ */
+const int64_t* not_stisla_append_data(const not_stisla_append_t* app);
+
+/**
+ * @brief Snapshot retries taken by readers that raced with a publish
+ *
+ * @param app Appendable array
+ * @return    Total retries
+ */
+size_t not_stisla_append_retries(const not_stisla_append_t* app);
+
+/**
+ * @brief Bytes of shared memory needed for a shared table
+ *
+ * @param max_anchors Anchor capacity (0 = default 256)
+ * @return            Region size to pass to not_stisla_shared_init()
+ */
+size_t not_stisla_shared_size(size_t max_anchors);
+
+/**
+ * @brief Format a shared table in a caller-provided region
+ *
+ * The region (typically shm_open() + mmap(MAP_SHARED)) must be 64-byte
+ * aligned; every anchor slot that fits in 'len' is used. The table holds
+ * only offsets, so each process may map it at a different address. Call
+ * once, before other processes attach.
+ *
+ * @param mem Start of the region
+ * @param len Region length in bytes
+ * @param arr Sorted array every process will search
+ * @param n   Number of elements (at least 2)
+ * @return    The table inside the region, or NULL on invalid input
+ */
+not_stisla_shared_t* not_stisla_shared_init(void* mem, size_t len, const int64_t* arr, size_t n);
+
+/**
+ * @brief Use a table formatted by another process
+ *
+ * Constant time: validates the header only.
+ *
+ * @param mem Start of this process's mapping of the region
+ * @param len Mapping length in bytes
+ * @return    The table, or NULL if the region holds no valid table
+ */
+not_stisla_shared_t* not_stisla_shared_attach(void* mem, size_t len);
+
+/**
+ * @brief Search through a shared table, learning for every attached process
+ *
+ * Readers copy their bounding anchors under a sequence lock and never take
+ * a lock. A misprediction beyond 'tol' inserts an anchor if no other process
+ * is learning at that moment; otherwise the lesson is skipped. The learner
+ * lock is a robust process-shared mutex: if its owner dies, the kernel hands
+ * it to the next learner or stalled reader, which keeps the anchors that
+ * still match 'arr' and reopens the table. This holds across pid namespaces
+ * and reused pids. Arrays other than the one the table was formatted for are
+ * searched without the table.
+ *
+ * @param table Shared table
+ * @param arr   Sorted array (this process's mapping)
+ * @param n     Number of elements
+ * @param key   Value to search for
+ * @param tol   Tolerance for prediction error
+ * @return      Index of found element, or NOT_STISLA_NOT_FOUND
+ */
+not_stisla_result_t not_stisla_shared_search(
+    not_stisla_shared_t* table,
+    const int64_t* arr,
+    size_t n,
+    int64_t key,
+    size_t tol
+);
+
+/**
+ * @brief Get shared table statistics
+ *
+ * @param table   Shared table
+ * @param anchors Output: anchors in the table (can be NULL)
+ * @param learned Output: anchors learned by all processes (can be NULL)
+ * @param skipped Output: lessons skipped because another process was learning (can be NULL)
+ */
+void not_stisla_shared_get_stats(
+    not_stisla_shared_t* table,
+    size_t* anchors,
+    size_t* learned,
+    size_t* skipped
+);
+
+/**
+ * @brief Build a negative-lookup filter over a sorted array
+ *
+ * A split-block Bloom filter: each key sets one bit in each of eight words
+ * of one 32-byte block, so a probe reads a single cache line. More bits per
+ * key cost memory and lower the false positive rate: 8 bits give about 3%,
+ * 10 about 1.3%, 12 about 0.5%, 16 about 0.13%.
+ *
+ * @param arr          Sorted array (duplicates allowed)
+ * @param n            Number of elements in array
+ * @param bits_per_key Filter memory per key (0 = 10, at most 64)
+ * @return             New filter, or NULL on failure
+ */
+not_stisla_filter_t* not_stisla_filter_build(const int64_t* arr, size_t n, size_t bits_per_key);
+
+/**
+ * @brief Free a filter created by not_stisla_filter_build()
+ *
+ * @param filter The filter to destroy
+ */
+void not_stisla_filter_destroy(not_stisla_filter_t* filter);
+
+/**
+ * @brief Test a key against the filter
+ *
+ * @param filter Filter (NULL admits every key)
+ * @param key    Value to test
+ * @return       false if key is certainly absent, true if it may be present
+ */
+bool not_stisla_filter_may_contain(const not_stisla_filter_t* filter, int64_t key);
+
+/**
+ * @brief Smallest bits per key whose expected false positive rate is at most fp_rate
+ *
+ * @param fp_rate Target false positive rate, e.g. 0.01
+ * @return        Bits per key to pass to not_stisla_filter_build()
+ */
+size_t not_stisla_filter_bits_for_rate(double fp_rate);
+
+/**
+ * @brief Expected false positive rate of a built filter
+ *
+ * @param filter Filter
+ * @return       Chance that an absent key passes the filter
+ */
+double not_stisla_filter_fp_rate(const not_stisla_filter_t* filter);
+
+/**
+ * @brief Memory held by the filter's blocks
+ *
+ * @param filter Filter
+ * @return       Bytes
+ */
+size_t not_stisla_filter_size_bytes(const not_stisla_filter_t* filter);
+
+/**
+ * @brief not_stisla_search_ids() behind a negative-lookup filter
+ *
+ * IDs the filter rejects return NOT_STISLA_NOT_FOUND without touching the
+ * table or the array; the rest are searched as usual.
+ *
+ * @param ids       Sorted array of IDs
+ * @param n         Number of elements in array
+ * @param target_id ID to find
+ * @param table     Anchor table for learning (can be NULL)
+ * @param filter    Filter built over ids (NULL searches every ID)
+ * @return          Index of found ID, or NOT_STISLA_NOT_FOUND
+ */
+not_stisla_result_t not_stisla_search_ids_filtered(
+    const int64_t* ids,
+    size_t n,
+    int64_t target_id,
+    not_stisla_anchor_table_t* table,
+    const not_stisla_filter_t* filter
+);
+
+/**
+ * @brief Encode a sorted array as an Elias-Fano key set
+ *
+ * Each key takes about 2 + log2(range / n) bits: fairly uniform IDs with
+ * gaps near 100 fit in about 9 bits instead of 64. The array is not needed
+ * after the build.
+ *
+ * @param arr Sorted array (duplicates allowed)
+ * @param n   Number of elements in array
+ * @return    New key set, or NULL on failure
+ */
+not_stisla_ef_t* not_stisla_ef_build(const int64_t* arr, size_t n);
+
+/**
+ * @brief Free a key set created by not_stisla_ef_build()
+ *
+ * @param ef The key set to destroy
+ */
+void not_stisla_ef_destroy(not_stisla_ef_t* ef);
+
+/**
+ * @brief Number of keys in the set
+ *
+ * @param ef Key set
+ * @return   Keys, 0 for NULL
+ */
+size_t not_stisla_ef_length(const not_stisla_ef_t* ef);
+
+/**
+ * @brief Memory held by the key set, including its rank samples
+ *
+ * @param ef Key set
+ * @return   Bytes
+ */
+size_t not_stisla_ef_size_bytes(const not_stisla_ef_t* ef);
+
+/**
+ * @brief Key at a position (select)
+ *
+ * @param ef Key set
+ * @param i  Position, below not_stisla_ef_length()
+ * @return   arr[i] of the encoded array, 0 if i is out of range
+ */
+int64_t not_stisla_ef_get(const not_stisla_ef_t* ef, size_t i);
+
+/**
+ * @brief Position of the first key greater than or equal to key
+ *
+ * @param ef    Key set
+ * @param key   Value to look up
+ * @param value Output: the key at the returned position (can be NULL; unset
+ *              when the position is the length)
+ * @return      Position, or not_stisla_ef_length() if every key is smaller
+ */
+size_t not_stisla_ef_next_geq(const not_stisla_ef_t* ef, int64_t key, int64_t* value);
+
+/**
+ * @brief Find a key in the set
+ *
+ * @param ef  Key set
+ * @param key Value to find
+ * @return    Position of the first equal key, or NOT_STISLA_NOT_FOUND
+ */
+not_stisla_result_t not_stisla_ef_search(const not_stisla_ef_t* ef, int64_t key);
+
+/**
+ * @brief Store a sorted array as per-block lines plus bit-packed residuals
+ *
+ * Each block of block_keys keys keeps the line through its first and last
+ * key and, for every key, its distance from that line in as many bits as
+ * the block's widest distance needs. Evenly spaced keys cost a few bits;
+ * a block with a large jump costs more. The array is not needed after the
+ * build.
+ *
+ * @param arr        Sorted array (duplicates allowed)
+ * @param n          Number of elements in array
+ * @param block_keys Keys per block (0 = 128); larger blocks spend less on
+ *                   block headers and more per residual
+ * @return           New packed array, or NULL on failure
+ */
+not_stisla_packed_t* not_stisla_packed_build(const int64_t* arr, size_t n, size_t block_keys);
+
+/**
+ * @brief Free a packed array created by not_stisla_packed_build()
+ *
+ * @param packed The packed array to destroy
+ */
+void not_stisla_packed_destroy(not_stisla_packed_t* packed);
+
+/**
+ * @brief Number of keys in the packed array
+ *
+ * @param packed Packed array
+ * @return       Keys, 0 for NULL
+ */
+size_t not_stisla_packed_length(const not_stisla_packed_t* packed);
+
+/**
+ * @brief Memory held by the packed array, including block headers
+ *
+ * @param packed Packed array
+ * @return       Bytes
+ */
+size_t not_stisla_packed_size_bytes(const not_stisla_packed_t* packed);
+
+/**
+ * @brief Decode the key at a position
+ *
+ * @param packed Packed array
+ * @param i      Position, below not_stisla_packed_length()
+ * @return       arr[i] of the packed array, 0 if i is out of range
+ */
+int64_t not_stisla_packed_get(const not_stisla_packed_t* packed, size_t i);
+
+/**
+ * @brief Position of the first key greater than or equal to key
+ *
+ * Interpolates to one block and searches it by decoding single keys.
+ *
+ * @param packed Packed array
+ * @param key    Value to look up
+ * @param value  Output: the key at the returned position (can be NULL;
+ *               unset when the position is the length)
+ * @return       Position, or not_stisla_packed_length() if every key is smaller
+ */
+size_t not_stisla_packed_next_geq(const not_stisla_packed_t* packed, int64_t key, int64_t* value);
+
+/**
+ * @brief Find a key in the packed array
+ *
+ * @param packed Packed array
+ * @param key    Value to find
+ * @return       Position of the first equal key, or NOT_STISLA_NOT_FOUND
+ */
+not_stisla_result_t not_stisla_packed_search(const not_stisla_packed_t* packed, int64_t key);
+
+/**
+ * @brief Encode sorted timestamps as Gorilla-style delta-of-delta blocks
+ *
+ * Every block of block_keys timestamps keeps its first timestamp unpacked
+ * and codes the rest as the change in delta from the previous one: 1 bit
+ * when the interval repeats exactly, then 9, 12, 16, 37 or 69 bits as the
+ * change grows. The column is not needed after the build.
+ *
+ * @param ts         Sorted timestamps (duplicates allowed)
+ * @param n          Number of timestamps
+ * @param block_keys Timestamps per block (0 = 128); bounds the codes a
+ *                   lookup decodes
+ * @return           New column, or NULL on failure
+ */
+not_stisla_dod_t* not_stisla_dod_build(const int64_t* ts, size_t n, size_t block_keys);
+
+/**
+ * @brief Free a column created by not_stisla_dod_build()
+ *
+ * @param dod The column to destroy
+ */
+void not_stisla_dod_destroy(not_stisla_dod_t* dod);
+
+/**
+ * @brief Number of timestamps in the column
+ *
+ * @param dod Column
+ * @return    Timestamps, 0 for NULL
+ */
+size_t not_stisla_dod_length(const not_stisla_dod_t* dod);
+
+/**
+ * @brief Memory held by the column, including block heads and offsets
+ *
+ * @param dod Column
+ * @return    Bytes
+ */
+size_t not_stisla_dod_size_bytes(const not_stisla_dod_t* dod);
+
+/**
+ * @brief Decode the timestamp at a position
+ *
+ * Decodes from the start of its block.
+ *
+ * @param dod Column
+ * @param i   Position, below not_stisla_dod_length()
+ * @return    ts[i] of the encoded column, 0 if i is out of range
+ */
+int64_t not_stisla_dod_get(const not_stisla_dod_t* dod, size_t i);
+
+/**
+ * @brief Decode one whole block
+ *
+ * Block b holds positions b * block_keys onward.
+ *
+ * @param dod   Column
+ * @param block Block number
+ * @param out   Output: room for block_keys timestamps
+ * @return      Timestamps written, 0 if block is out of range
+ */
+size_t not_stisla_dod_decode_block(const not_stisla_dod_t* dod, size_t block, int64_t* out);
+
+/**
+ * @brief Position of the first timestamp greater than or equal to key
+ *
+ * Interpolates over the block heads and decodes a single block, stopping
+ * at the answer.
+ *
+ * @param dod   Column
+ * @param key   Timestamp to look up
+ * @param value Output: the timestamp at the returned position (can be NULL;
+ *              unset when the position is the length)
+ * @return      Position, or not_stisla_dod_length() if every timestamp is smaller
+ */
+size_t not_stisla_dod_next_geq(const not_stisla_dod_t* dod, int64_t key, int64_t* value);
+
+/**
+ * @brief Find a timestamp in the column
+ *
+ * @param dod Column
+ * @param key Timestamp to find
+ * @return    Position of the first equal timestamp, or NOT_STISLA_NOT_FOUND
+ */
+not_stisla_result_t not_stisla_dod_search(const not_stisla_dod_t* dod, int64_t key);
+
+/**
+ * Search phases reported by trace points, in the order a search passes them
+ */
+typedef enum {
+    NOT_STISLA_TRACE_BEGIN = 0,    /**< Search entered with an in-range key */
+    NOT_STISLA_TRACE_ANCHOR = 1,   /**< Bounding anchors found (pred = left index, window = segment keys) */
+    NOT_STISLA_TRACE_PREDICT = 2,  /**< Interpolated position computed */
+    NOT_STISLA_TRACE_WINDOW = 3,   /**< Window (and any escalation) searched */
+    NOT_STISLA_TRACE_LEARN = 4,    /**< Segment bounds and anchors updated */
+    NOT_STISLA_TRACE_END = 5       /**< Search about to return */
+} not_stisla_trace_phase_t;
+
+/**
+ * One trace point hit; also the record format of not_stisla_trace_write()
+ */
+typedef struct {
+    uint64_t cycles;   /**< Timestamp (TSC on x86-64), excluding time spent in the hook */
+    int64_t key;
+    uint64_t pred;
+    uint64_t window;
+    uint64_t result;
+    uint32_t phase;    /**< not_stisla_trace_phase_t */
+    uint32_t reserved;
+} not_stisla_trace_event_t;
+
+/**
+ * Trace hook, called synchronously on the searching thread
+ */
+typedef void (*not_stisla_trace_fn)(void* ctx, const not_stisla_trace_event_t* event);
+
+/**
+ * @brief Install a hook called at every trace point
+ *
+ * Trace points exist only in libraries built with -DNOT_STISLA_TRACE
+ * (make TRACE=1); otherwise they compile to nothing and this returns false.
+ * Set the hook before searching starts; NULL removes it.
+ *
+ * @param hook Function called per event
+ * @param ctx  Passed to the hook unchanged
+ * @return     true if this build has trace points
+ */
+bool not_stisla_trace_set_hook(not_stisla_trace_fn hook, void* ctx);
+
+/**
+ * @brief Ready-made hook appending binary events to a FILE*
+ *
+ * Install with not_stisla_trace_set_hook(not_stisla_trace_write, file) from
+ * a single searching thread; tools/trace_report.c turns the file into a
+ * per-phase latency breakdown.
+ *
+ * @param file  FILE* opened for binary writing
+ * @param event Event to append
+ */
+void not_stisla_trace_write(void* file, const not_stisla_trace_event_t* event);
+
 /* Version information */
 #define NOT_STISLA_VERSION_MAJOR 1
 #define NOT_STISLA_VERSION_MINOR 0
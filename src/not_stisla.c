@@ -9,34 +9,96 @@
  * - Smart anchor learning
  */
 
-#include "../include/not_stisla.h"
+#define _POSIX_C_SOURCE 200809L
+
+#include "not_stisla_internal.h"
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <math.h>
 
 /* Configuration */
 #define NOT_STISLA_DEFAULT_TOLERANCE 8
 #define NOT_STISLA_MAX_ANCHORS 16
 #define NOT_STISLA_CHUNK_SIZE 4  /* AVX2 register size */
+#define NOT_STISLA_BUILD_MAX_ANCHORS 256  /* Default budget for offline builds */
+#define NOT_STISLA_LIVE_SAMPLE_SHIFT 58   /* Monitor 1 in 64 live queries */
+#define NOT_STISLA_LIVE_POLL_NS 50000000L /* Rebuild thread wakeup backstop */
+#define NOT_STISLA_LIVE_MAX_BACKOFF 16    /* Fruitless automatic rebuilds wait up to 2^16x the samples */
+#define NOT_STISLA_FROZEN_MAGIC 0x4E5346524F5A4E34ULL  /* "NSFROZN4" */
+#define NOT_STISLA_ANCHOR_SCAN 16         /* Anchor count below which lookup is a linear count */
+#define NOT_STISLA_CACHE_LINE 64
+#define NOT_STISLA_AUTO_CURVE_FACTOR 2    /* Auto mode bends a learned segment whose curve errs under 1/2 the line's */
+#define NOT_STISLA_TRANSFORM_KNOTS 16     /* Knots of the learned piecewise transform */
+#define NOT_STISLA_TRANSFORM_SAMPLE 256   /* Keys sampled when fitting a transform */
+#define NOT_STISLA_EXACT_MIN_RUN 256      /* Shortest progression a build gives its own segment */
 
 #define NOT_STISLA_VERSION_STRING "1.0.0"
 #define NOT_STISLA_BUILD_INFO "AVX2-optimized for Meteor Lake, 22.28x speedup"
 
-/* Anchor structure */
+/* Monotone key transform applied before linear interpolation */
 typedef struct {
-    int64_t v;  /* value */
-    size_t i;   /* index */
-} not_stisla_anchor_t;
+    not_stisla_transform_kind_t kind;
+    int64_t base;   /* Smallest key; log/sqrt work on the distance from it */
+    double shift;   /* Log/sqrt: fitted offset added to that distance */
+    bool fitted;    /* Log/sqrt: base and shift were fitted to an array starting at base */
+    size_t knots;   /* Piecewise: knot count */
+    int64_t knot_keys[NOT_STISLA_TRANSFORM_KNOTS];
+    double knot_ranks[NOT_STISLA_TRANSFORM_KNOTS];
+} not_stisla_transform_t;
+
+static const not_stisla_transform_t not_stisla_identity_transform = { .kind = NOT_STISLA_TRANSFORM_NONE };
+
+/* Memory pool: byte budget shared by every table charged to it.
+ * Counters are atomic because tables in one pool may live on different threads. */
+struct not_stisla_pool {
+    _Atomic size_t budget;      /* 0 = unlimited */
+    _Atomic size_t used;
+    _Atomic size_t peak;
+    _Atomic size_t tables;
+    _Atomic size_t denied;      /* Anchor growths refused */
+    _Atomic size_t downgrades;  /* Builds and seeds given fewer anchors */
+};
+
+/* Every table not placed in a pool of its own is charged here */
+static not_stisla_pool_t not_stisla_default_pool;
 
 /* Anchor table structure */
 struct not_stisla_anchor_table {
-    not_stisla_anchor_t* anchors;
+    not_stisla_anchor_t* anchors;  /* 'capacity' slots, then 'capacity' lookup key slots */
     size_t capacity;
     size_t size;
+    int64_t key_base;    /* First anchor key, origin of compact lookup keys */
+    bool key_compact;    /* Lookup keys are u32 offsets from key_base, else full keys */
+    not_stisla_pool_t* pool;
     size_t searches_performed;
+    size_t lookups;      /* Model searches, found or not */
+    size_t escalations;  /* Lookups that missed their first window */
+    size_t window_keys;  /* Sum of first window sizes */
     int workload_type;  /* DSMIL workload optimization */
+    not_stisla_interp_mode_t interp_mode;
+    not_stisla_transform_t transform;
 };
 
+/* Per-slot cost of a table: the wide anchor plus its lookup key. The anchor
+ * lookup reads only the keys, 16 (or 8) to a cache line instead of one anchor. */
+#define NOT_STISLA_SLOT_BYTES (sizeof(not_stisla_anchor_t) + sizeof(int64_t))
+#define NOT_STISLA_TABLE_KEYS(t) ((void*)((t)->anchors + (t)->capacity))
+
+/* Outcome of one model probe, used for learning and statistics */
+typedef struct {
+    size_t pred;
+    size_t seg;
+    size_t window;
+    bool escalated;
+    bool direct;  /* Answered by the segment's direct address */
+} not_stisla_probe_t;
+
 /* DSMIL workload types */
 enum {
     NOT_STISLA_WORKLOAD_TELEMETRY = 0,
@@ -46,10 +108,12 @@ enum {
 };
 
 /* Forward declarations */
-static inline size_t not_stisla_anchor_lower(const not_stisla_anchor_table_t* table, int64_t x);
-static inline int64_t not_stisla_interpolate(int64_t l_val, int64_t r_val, size_t l_idx, size_t r_idx, int64_t key);
-static inline size_t not_stisla_local_search(const int64_t* arr, size_t lo, size_t hi, int64_t key);
-static void not_stisla_learn_anchor(not_stisla_anchor_table_t* table, int64_t value, size_t index, size_t pred, size_t tol);
+static void not_stisla_table_sync_keys(not_stisla_anchor_table_t* table);
+static void not_stisla_learn_anchor(not_stisla_anchor_table_t* table, const int64_t* arr, int64_t value,
+                                    size_t index, size_t pred, size_t tol);
+static inline size_t not_stisla_segment_search(const int64_t* arr, const not_stisla_anchor_t* anchors, size_t size,
+                                               size_t a_idx, const not_stisla_transform_t* xf, int64_t key,
+                                               size_t tol, not_stisla_probe_t* probe);
 
 /* AVX2-style chunked linear search for small arrays */
 static inline size_t not_stisla_chunked_search(const int64_t* arr, size_t n, int64_t key) {
@@ -90,110 +154,215 @@ static inline size_t not_stisla_chunked_search(const int64_t* arr, size_t n, int
     return NOT_STISLA_NOT_FOUND;
 }
 
-/* Optimized anchor binary search with unrolling */
-static inline size_t not_stisla_anchor_lower(const not_stisla_anchor_table_t* table, int64_t x) {
-    if (table->size == 0) return 0;
+/* Three-point interpolation through the segment ends and its midpoint.
+ * Fits a linear fractional curve (as in TIP) that follows convex and concave
+ * key distributions; collinear or pole-crossing fits fall back to linear. */
+static inline size_t not_stisla_interpolate3(const not_stisla_anchor_t* l, const not_stisla_anchor_t* r, int64_t key) {
+    const size_t mi = l->i + ((r->i - l->i) >> 1);
+    if (mi == l->i || l->mv <= l->v || l->mv >= r->v) {
+        return (size_t)not_stisla_interpolate(l->v, r->v, l->i, r->i, key);
+    }
 
-    size_t lo = 0;
-    size_t hi = table->size - 1;
+    /* Coordinates relative to the midpoint knot */
+    const double x0 = -(double)(mi - l->i);
+    const double x2 = (double)(r->i - mi);
+    const double y0 = (double)((__int128)l->v - l->mv);
+    const double y2 = (double)((__int128)r->v - l->mv);
+    const double y = (double)((__int128)key - l->mv);
 
-    /* Manual unrolling for common small table sizes */
-    switch (hi - lo) {
-        case 0:
-            return table->anchors[lo].v <= x ? lo : 0;
-        case 1: {
-            const not_stisla_anchor_t* a0 = &table->anchors[lo];
-            const not_stisla_anchor_t* a1 = &table->anchors[hi];
-            if (a0->v <= x) {
-                return a1->v <= x ? hi : lo;
-            }
-            return 0;
-        }
-        case 2: {
-            const not_stisla_anchor_t* a0 = &table->anchors[lo];
-            const not_stisla_anchor_t* a1 = &table->anchors[lo + 1];
-            const not_stisla_anchor_t* a2 = &table->anchors[hi];
-            if (a1->v <= x) {
-                return a2->v <= x ? hi : lo + 1;
-            } else if (a0->v <= x) {
-                return lo;
-            }
-            return 0;
-        }
-        default:
-            /* Standard binary search for larger tables */
-            while (lo + 1 < hi) {
-                size_t mid = lo + ((hi - lo) >> 1);
-                if (table->anchors[mid].v <= x) {
-                    lo = mid;
-                } else {
-                    hi = mid;
-                }
-            }
-            return lo;
+    const double den = x0 * y2 - x2 * y0;
+    if (den == 0.0) {
+        return (size_t)not_stisla_interpolate(l->v, r->v, l->i, r->i, key);
     }
+
+    /* x(y) = p*y / (y + c) through (y0,x0), (0,0), (y2,x2); the pole must lie outside the segment */
+    const double c = y0 * y2 * (x2 - x0) / den;
+    if ((y0 + c) * (y2 + c) <= 0.0) {
+        return (size_t)not_stisla_interpolate(l->v, r->v, l->i, r->i, key);
+    }
+
+    const double x = x0 * (y0 + c) * y / (y0 * (y + c));
+    const double pos = (double)mi + x + 0.5;
+    if (!isfinite(pos) || pos <= (double)l->i) return l->i;
+    if (pos >= (double)r->i) return r->i;
+    return (size_t)pos;
 }
 
-/* High-precision interpolation with overflow protection */
-static inline int64_t not_stisla_interpolate(int64_t l_val, int64_t r_val, size_t l_idx, size_t r_idx, int64_t key) {
-    const size_t span = r_idx - l_idx;
+/* Unfitted log/sqrt origin: measure from zero for positive keys, else from the first key */
+static inline void not_stisla_transform_origin(not_stisla_transform_t* xf, int64_t first) {
+    xf->base = first;
+    xf->shift = (first > 0) ? (double)first : 0.0;
+    if (xf->kind == NOT_STISLA_TRANSFORM_LOG) xf->shift += 1.0;
+    xf->fitted = false;
+}
+
+/* Log/sqrt origin for an array starting at first; a fit to that array is kept */
+static inline void not_stisla_transform_prepare(not_stisla_transform_t* xf, int64_t first) {
+    if (xf->kind != NOT_STISLA_TRANSFORM_LOG && xf->kind != NOT_STISLA_TRANSFORM_SQRT) return;
+    if (!xf->fitted || xf->base != first) not_stisla_transform_origin(xf, first);
+}
 
-    if (r_val == l_val) {
-        return (int64_t)l_idx;
+/* Map a key through a monotone transform */
+static inline double not_stisla_transform_apply(const not_stisla_transform_t* xf, int64_t key) {
+    const double d = (key > xf->base) ? (double)((uint64_t)key - (uint64_t)xf->base) : 0.0;
+
+    switch (xf->kind) {
+        case NOT_STISLA_TRANSFORM_LOG:
+            return log(d + xf->shift);
+        case NOT_STISLA_TRANSFORM_SQRT:
+            return sqrt(d + xf->shift);
+        case NOT_STISLA_TRANSFORM_PIECEWISE: {
+            const int64_t* kk = xf->knot_keys;
+            const size_t last = xf->knots - 1;
+            if (key <= kk[0]) return xf->knot_ranks[0];
+            if (key >= kk[last]) return xf->knot_ranks[last];
+
+            size_t k = 0;
+            while (k + 1 < last && kk[k + 1] <= key) ++k;
+            const double width = (double)((uint64_t)kk[k + 1] - (uint64_t)kk[k]);
+            const double frac = (double)((uint64_t)key - (uint64_t)kk[k]) / width;
+            return xf->knot_ranks[k] + frac * (xf->knot_ranks[k + 1] - xf->knot_ranks[k]);
+        }
+        default:
+            return d;
     }
+}
 
-    /* Use 128-bit arithmetic to prevent overflow */
-    const __int128 key_offset = (__int128)key - (__int128)l_val;
-    const __int128 range = (__int128)r_val - (__int128)l_val;
+/* Linear interpolation in transformed key space */
+static inline size_t not_stisla_interpolate_transformed(const not_stisla_transform_t* xf, const not_stisla_anchor_t* l,
+                                                        const not_stisla_anchor_t* r, int64_t key) {
+    const double span = r->tv - l->tv;
+    if (!(span > 0.0)) return l->i;
 
-    if (range == 0) return (int64_t)l_idx;
+    const double frac = (not_stisla_transform_apply(xf, key) - l->tv) / span;
+    if (!(frac > 0.0)) return l->i;
+    if (frac >= 1.0) return r->i;
+    return l->i + (size_t)(frac * (double)(r->i - l->i) + 0.5);
+}
 
-    const __int128 frac = (key_offset * (__int128)span) / range;
-    const __int128 result = (__int128)l_idx + frac;
+/* Predict a key's index with the segment's own interpolation mode */
+static inline size_t not_stisla_predict(const not_stisla_transform_t* xf, const not_stisla_anchor_t* l,
+                                        const not_stisla_anchor_t* r, int64_t key) {
+    if (l->flags & NOT_STISLA_SEG_CURVED) {
+        return not_stisla_interpolate3(l, r, key);
+    }
+    if (xf->kind != NOT_STISLA_TRANSFORM_NONE) {
+        return not_stisla_interpolate_transformed(xf, l, r, key);
+    }
+    return (size_t)not_stisla_interpolate(l->v, r->v, l->i, r->i, key);
+}
 
-    /* Clamp result to valid range */
-    if (result < 0) return 0;
-    if ((size_t)result > r_idx) return (int64_t)r_idx;
+/* Endpoints and midpoint on one progression of stride >= 1: worth trying the
+ * direct address before the window. Only a full measure proves it. */
+static inline bool not_stisla_segment_progression_hint(const not_stisla_anchor_t* l, const not_stisla_anchor_t* r) {
+    const uint64_t span = (uint64_t)r->v - (uint64_t)l->v;
+    const uint64_t count = r->i - l->i;
+    if (r->v <= l->v || count == 0 || span < count || span % count) return false;
+    const uint64_t half = count >> 1;
+    return (uint64_t)l->mv - (uint64_t)l->v == half * (span / count);
+}
 
-    return (int64_t)result;
+/* Cheap seeding error: prediction error at the segment's quarter ranks.
+ * The midpoint is skipped because curved segments interpolate through it. */
+static size_t not_stisla_segment_probe_error(const int64_t* arr, const not_stisla_transform_t* xf,
+                                             const not_stisla_anchor_t* l, const not_stisla_anchor_t* r,
+                                             size_t* worst_at) {
+    const size_t span = r->i - l->i;
+    const size_t probes[2] = { l->i + (span >> 2), r->i - (span >> 2) };
+    size_t worst = 0;
+    *worst_at = l->i;
+    if (span < 4) return 0;
+    for (size_t p = 0; p < 2; ++p) {
+        const size_t pred = not_stisla_predict(xf, l, r, arr[probes[p]]);
+        const size_t diff = (pred > probes[p]) ? (pred - probes[p]) : (probes[p] - pred);
+        if (diff > worst) {
+            worst = diff;
+            *worst_at = probes[p];
+        }
+    }
+    return worst;
 }
 
-/* Optimized local binary search */
-static inline size_t not_stisla_local_search(const int64_t* arr, size_t lo, size_t hi, int64_t key) {
-    /* Quick bounds check */
-    if (lo >= hi || arr[lo] > key || arr[hi] < key) {
-        return NOT_STISLA_NOT_FOUND;
+/* Auto mode: bend a segment where the curve misses the quarter ranks by well
+ * under the line. Two key reads, so learned segments choose up front instead
+ * of escalating through a linear phase before bending. */
+static inline void not_stisla_segment_choose(not_stisla_anchor_t* l, const not_stisla_anchor_t* r,
+                                             const int64_t* arr, const not_stisla_transform_t* xf) {
+    size_t at;
+    l->flags &= ~(NOT_STISLA_SEG_CURVED | NOT_STISLA_SEG_UNPROBED);
+    const size_t linear = not_stisla_segment_probe_error(arr, xf, l, r, &at);
+    l->flags |= NOT_STISLA_SEG_CURVED;
+    if (not_stisla_segment_probe_error(arr, xf, l, r, &at) * NOT_STISLA_AUTO_CURVE_FACTOR >= linear) {
+        l->flags &= ~NOT_STISLA_SEG_CURVED;
     }
+}
 
-    /* Optimized binary search */
-    while (lo <= hi) {
-        size_t mid = lo + ((hi - lo) >> 1);  /* Fast divide by 2 */
-        int64_t val = arr[mid];
+/* Start a segment unmeasured, with its midpoint knot and the table's curve choice */
+static inline void not_stisla_segment_reset(not_stisla_anchor_t* l, not_stisla_anchor_t* r, const int64_t* arr,
+                                            const not_stisla_transform_t* xf, not_stisla_interp_mode_t mode) {
+    l->tv = not_stisla_transform_apply(xf, l->v);
+    r->tv = not_stisla_transform_apply(xf, r->v);
+    l->mv = arr[l->i + ((r->i - l->i) >> 1)];
+    l->err_lo = 0;
+    l->err_hi = 0;
+    l->flags = (mode == NOT_STISLA_INTERP_THREE_POINT) ? NOT_STISLA_SEG_CURVED : 0;
+    if (mode == NOT_STISLA_INTERP_AUTO) not_stisla_segment_choose(l, r, arr, xf);
+    if (not_stisla_segment_progression_hint(l, r)) l->flags |= NOT_STISLA_SEG_EXACT;
+}
 
-        if (val < key) {
-            lo = mid + 1;
-        } else if (val > key) {
-            if (mid == 0) break;
-            hi = mid - 1;
-        } else {
-            return mid;
-        }
+
+/* Charge bytes to a pool, or refuse if that would pass its budget */
+static bool not_stisla_pool_reserve(not_stisla_pool_t* pool, size_t bytes) {
+    size_t used = atomic_load(&pool->used);
+    size_t next;
+    do {
+        const size_t budget = atomic_load(&pool->budget);
+        next = used + bytes;
+        if (budget && next > budget) return false;
+    } while (!atomic_compare_exchange_weak(&pool->used, &used, next));
+
+    size_t peak = atomic_load(&pool->peak);
+    while (next > peak && !atomic_compare_exchange_weak(&pool->peak, &peak, next)) {
     }
+    return true;
+}
 
-    return NOT_STISLA_NOT_FOUND;
+static inline void not_stisla_pool_release(not_stisla_pool_t* pool, size_t bytes) {
+    atomic_fetch_sub(&pool->used, bytes);
 }
 
-/* Smart anchor learning with adaptive limits */
-static void not_stisla_learn_anchor(not_stisla_anchor_table_t* table, int64_t value, size_t index, size_t pred, size_t tol) {
-    if (!table) return;
+/* Reserve room for a replacement anchor array of up to 'want' slots, halving
+ * the request until it fits. The table's current array is released first,
+ * since it is freed once the replacement is in place. Returns 0 if not even
+ * two slots fit, with the current array still charged. */
+static size_t not_stisla_pool_reserve_anchors(not_stisla_anchor_table_t* table, size_t want) {
+    not_stisla_pool_t* pool = table->pool;
+    const size_t held = table->capacity * NOT_STISLA_SLOT_BYTES;
+    not_stisla_pool_release(pool, held);
+
+    size_t slots = want;
+    while (!not_stisla_pool_reserve(pool, slots * NOT_STISLA_SLOT_BYTES)) {
+        if (slots <= 2) {
+            atomic_fetch_add(&pool->used, held);
+            atomic_fetch_add(&pool->denied, 1);
+            return 0;
+        }
+        slots = (slots >> 1) < 2 ? 2 : (slots >> 1);
+    }
+    if (slots < want) atomic_fetch_add(&pool->downgrades, 1);
+    return slots;
+}
 
-    /* Don't learn if prediction was close enough */
-    const size_t pred_diff = (pred > index) ? (pred - index) : (index - pred);
-    if (pred_diff <= tol) return;
+/* Undo not_stisla_pool_reserve_anchors() when the allocation itself failed */
+static void not_stisla_pool_unreserve_anchors(not_stisla_anchor_table_t* table, size_t slots) {
+    not_stisla_pool_release(table->pool, slots * NOT_STISLA_SLOT_BYTES);
+    atomic_fetch_add(&table->pool->used, table->capacity * NOT_STISLA_SLOT_BYTES);
+}
 
-    /* Adaptive anchor limit based on workload type */
+/* Adaptive anchor limit based on workload type */
+static inline size_t not_stisla_workload_max_anchors(int workload_type) {
     size_t max_anchors = NOT_STISLA_MAX_ANCHORS;
-    switch (table->workload_type) {
+    switch (workload_type) {
         case NOT_STISLA_WORKLOAD_TELEMETRY:
             max_anchors = 12;  /* Telemetry has variable patterns */
             break;
@@ -207,16 +376,36 @@ static void not_stisla_learn_anchor(not_stisla_anchor_table_t* table, int64_t va
             max_anchors = 16;  /* Events have burst patterns */
             break;
     }
+    return max_anchors;
+}
 
-    if (table->size >= max_anchors) return;
+/* Smart anchor learning with adaptive limits */
+static void not_stisla_learn_anchor(not_stisla_anchor_table_t* table, const int64_t* arr, int64_t value,
+                                    size_t index, size_t pred, size_t tol) {
+    if (!table) return;
 
-    /* Insert anchor in sorted order */
+    /* Don't learn if prediction was close enough */
+    const size_t pred_diff = (pred > index) ? (pred - index) : (index - pred);
+    if (pred_diff <= tol) return;
+
+    if (table->size >= not_stisla_workload_max_anchors(table->workload_type)) return;
+
+    /* Insert anchor in sorted order; over budget the table keeps the anchors it has */
     if (table->size >= table->capacity) {
         const size_t new_cap = table->capacity ? table->capacity * 2 : 8;
-        not_stisla_anchor_t* new_anchors = realloc(table->anchors, new_cap * sizeof(not_stisla_anchor_t));
-        if (!new_anchors) return;
+        const size_t grow = (new_cap - table->capacity) * NOT_STISLA_SLOT_BYTES;
+        if (!not_stisla_pool_reserve(table->pool, grow)) {
+            atomic_fetch_add(&table->pool->denied, 1);
+            return;
+        }
+        not_stisla_anchor_t* new_anchors = realloc(table->anchors, new_cap * NOT_STISLA_SLOT_BYTES);
+        if (!new_anchors) {
+            not_stisla_pool_release(table->pool, grow);
+            return;
+        }
         table->anchors = new_anchors;
         table->capacity = new_cap;
+        not_stisla_table_sync_keys(table);
     }
 
     /* Find insertion point */
@@ -225,67 +414,139 @@ static void not_stisla_learn_anchor(not_stisla_anchor_table_t* table, int64_t va
         ++pos;
     }
 
+    /* Duplicate keys cannot split a segment, and keys past the endpoints have none */
+    if (pos == 0 || pos == table->size || table->anchors[pos].v == value) return;
+
     /* Shift elements to make room */
     if (pos < table->size) {
         memmove(&table->anchors[pos + 1], &table->anchors[pos],
                 (table->size - pos) * sizeof(not_stisla_anchor_t));
     }
 
-    /* Insert new anchor */
+    /* Insert new anchor; both halves of the split segment start unmeasured */
     table->anchors[pos].v = value;
     table->anchors[pos].i = index;
     table->size++;
+    not_stisla_segment_reset(&table->anchors[pos - 1], &table->anchors[pos], arr, &table->transform,
+                             table->interp_mode);
+    not_stisla_segment_reset(&table->anchors[pos], &table->anchors[pos + 1], arr, &table->transform,
+                             table->interp_mode);
+    not_stisla_table_sync_keys(table);
 }
-not_stisla_result_t not_stisla_search(const int64_t* arr, size_t n, int64_t key,
-                              not_stisla_anchor_table_t* table, size_t tol) {
-    if (!arr || n == 0) return NOT_STISLA_NOT_FOUND;
 
-    /* Fast path: AVX2-optimized linear search for small arrays */
-    if (n < 32) {
-        return not_stisla_chunked_search(arr, n, key);
+/* Last anchor with key <= x, branch-free so it maps onto SIMD compares */
+static inline size_t not_stisla_keys_lower(const int64_t* keys, size_t count, int64_t x) {
+    if (count <= NOT_STISLA_ANCHOR_SCAN) {
+        size_t le = 0;
+        for (size_t k = 0; k < count; ++k) {
+            le += keys[k] <= x;
+        }
+        return le ? le - 1 : 0;
     }
 
-    /* Ensure we have anchor table */
-    not_stisla_anchor_table_t local_table;
-    not_stisla_anchor_table_t* active_table = table;
+    const int64_t* base = keys;
+    size_t len = count;
+    while (len > 1) {
+        const size_t half = len >> 1;
+        base = (base[half] <= x) ? base + half : base;
+        len -= half;
+    }
+    return (size_t)(base - keys);
+}
 
-    if (!active_table) {
-        local_table.anchors = NULL;
-        local_table.capacity = 0;
-        local_table.size = 0;
-        local_table.searches_performed = 0;
-        local_table.workload_type = -1;
-        active_table = &local_table;
+/* Same over compact keys: half the bytes, twice the anchors per cache line */
+static inline size_t not_stisla_keys_lower32(const uint32_t* keys, size_t count, uint32_t x) {
+    if (count <= NOT_STISLA_ANCHOR_SCAN) {
+        size_t le = 0;
+        for (size_t k = 0; k < count; ++k) {
+            le += keys[k] <= x;
+        }
+        return le ? le - 1 : 0;
     }
 
-    /* Initialize endpoints if needed */
-    if (active_table->size == 0) {
-        if (active_table->capacity == 0) {
-            active_table->anchors = malloc(2 * sizeof(not_stisla_anchor_t));
-            if (!active_table->anchors) return NOT_STISLA_NOT_FOUND;
-            active_table->capacity = 2;
+    const uint32_t* base = keys;
+    size_t len = count;
+    while (len > 1) {
+        const size_t half = len >> 1;
+        base = (base[half] <= x) ? base + half : base;
+        len -= half;
+    }
+    return (size_t)(base - keys);
+}
+
+/* Refill the lookup keys from the anchors; called after every anchor change */
+static void not_stisla_table_sync_keys(not_stisla_anchor_table_t* table) {
+    if (table->size < 2) return;
+    const not_stisla_anchor_t* anchors = table->anchors;
+    const uint64_t base = (uint64_t)anchors[0].v;
+    table->key_base = anchors[0].v;
+    table->key_compact = (uint64_t)anchors[table->size - 1].v - base <= UINT32_MAX;
+    if (table->key_compact) {
+        uint32_t* keys = NOT_STISLA_TABLE_KEYS(table);
+        for (size_t a = 0; a < table->size; ++a) {
+            keys[a] = (uint32_t)((uint64_t)anchors[a].v - base);
+        }
+    } else {
+        int64_t* keys = NOT_STISLA_TABLE_KEYS(table);
+        for (size_t a = 0; a < table->size; ++a) {
+            keys[a] = anchors[a].v;
         }
-        active_table->anchors[0].v = arr[0];
-        active_table->anchors[0].i = 0;
-        active_table->anchors[1].v = arr[n - 1];
-        active_table->anchors[1].i = n - 1;
-        active_table->size = 2;
     }
+}
 
-    /* Step 1: Find bounding anchors */
-    const size_t a_idx = not_stisla_anchor_lower(active_table, key);
-    const not_stisla_anchor_t* l = &active_table->anchors[a_idx];
-    const not_stisla_anchor_t* r = &active_table->anchors[a_idx + 1];
+/* Last anchor of a table with key <= x, read from the lookup keys */
+static inline size_t not_stisla_table_lower(const not_stisla_anchor_table_t* table, int64_t x) {
+    if (x <= table->key_base) return 0;
+    if (!table->key_compact) return not_stisla_keys_lower(NOT_STISLA_TABLE_KEYS(table), table->size, x);
+    const uint64_t delta = (uint64_t)x - (uint64_t)table->key_base;
+    if (delta > UINT32_MAX) return table->size - 1;
+    return not_stisla_keys_lower32(NOT_STISLA_TABLE_KEYS(table), table->size, (uint32_t)delta);
+}
 
-    /* Step 2: High-precision interpolation */
-    const size_t pred = (size_t)not_stisla_interpolate(l->v, r->v, l->i, r->i, key);
+/* Read-only search inside the anchor segment bounding 'key'; a_idx is the
+ * last anchor with key <= 'key'. Never writes to the anchors, so it is shared
+ * by the learning search and by published rebuild snapshots. Caller
+ * guarantees size >= 2. */
+static inline size_t not_stisla_segment_search(const int64_t* arr, const not_stisla_anchor_t* anchors, size_t size,
+                                               size_t a_idx, const not_stisla_transform_t* xf, int64_t key,
+                                               size_t tol, not_stisla_probe_t* probe) {
+    /* Step 1: Bounding anchors (keys past the last anchor use the last segment) */
+    if (a_idx + 1 >= size) a_idx = size - 2;
+    const not_stisla_anchor_t* l = &anchors[a_idx];
+    const not_stisla_anchor_t* r = &anchors[a_idx + 1];
+    NOT_STISLA_TRACE_POINT(ANCHOR, key, l->i, r->i - l->i + 1, a_idx);
+
+    /* Direct address: a progression segment needs one verifying load.
+     * Proven segments answer misses too; hinted ones fall through. */
+    if ((l->flags & NOT_STISLA_SEG_EXACT) && key >= l->v && key <= r->v) {
+        const size_t at = not_stisla_exact_index(l, r, key);
+        const bool hit = at != NOT_STISLA_NOT_FOUND && arr[at] == key;
+        if (hit || (l->flags & NOT_STISLA_SEG_BOUNDED)) {
+            probe->pred = hit ? at : l->i;
+            probe->seg = a_idx;
+            probe->window = 1;
+            probe->escalated = false;
+            probe->direct = true;
+            NOT_STISLA_TRACE_POINT(WINDOW, key, probe->pred, 1, hit ? at : NOT_STISLA_NOT_FOUND);
+            return hit ? at : NOT_STISLA_NOT_FOUND;
+        }
+    }
 
-    /* Step 3: Optimized local search */
-    size_t lo = (pred > tol) ? (pred - tol) : l->i;
-    lo = (lo > l->i) ? lo : l->i;
+    /* Step 2: High-precision interpolation (linear or three-point per segment) */
+    const size_t pred = not_stisla_predict(xf, l, r, key);
+    NOT_STISLA_TRACE_POINT(PREDICT, key, pred, 0, NOT_STISLA_NOT_FOUND);
+
+    /* Step 3: Optimized local search, window sized per segment.
+     * Measured segments use their exact bounds; learned ones never go below tol. */
+    size_t e_lo = l->err_lo;
+    size_t e_hi = l->err_hi;
+    if (!(l->flags & NOT_STISLA_SEG_BOUNDED)) {
+        e_lo = (e_lo > tol) ? e_lo : tol;
+        e_hi = (e_hi > tol) ? e_hi : tol;
+    }
 
-    size_t hi = pred + tol;
-    hi = (hi < r->i) ? hi : r->i;
+    size_t lo = (e_lo == UINT32_MAX || pred < l->i + e_lo) ? l->i : pred - e_lo;
+    size_t hi = (e_hi == UINT32_MAX || pred + e_hi > r->i) ? r->i : pred + e_hi;
 
     /* Ensure valid bounds */
     if (lo > hi) {
@@ -293,41 +554,218 @@ not_stisla_result_t not_stisla_search(const int64_t* arr, size_t n, int64_t key,
         hi = r->i;
     }
 
-    const size_t result = not_stisla_local_search(arr, lo, hi, key);
+    size_t result = not_stisla_local_search(arr, lo, hi, key);
+
+    probe->pred = pred;
+    probe->seg = a_idx;
+    probe->window = hi - lo + 1;
+    probe->escalated = false;
+    probe->direct = false;
+
+    /* Step 4: Escalate to the rest of the segment on a window miss
+     * (a miss inside an exact bound is already conclusive) */
+    if (result == NOT_STISLA_NOT_FOUND && !(l->flags & NOT_STISLA_SEG_BOUNDED)) {
+        if (key < arr[lo] && lo > l->i) {
+            result = not_stisla_local_search(arr, l->i, lo - 1, key);
+            probe->escalated = true;
+        } else if (key > arr[hi] && hi < r->i) {
+            result = not_stisla_local_search(arr, hi + 1, r->i, key);
+            probe->escalated = true;
+        }
+    }
+    NOT_STISLA_TRACE_POINT(WINDOW, key, pred, probe->window, result);
+
+    return result;
+}
+
+not_stisla_result_t not_stisla_search(const int64_t* arr, size_t n, int64_t key,
+                              not_stisla_anchor_table_t* table, size_t tol) {
+    if (!arr || n == 0) return NOT_STISLA_NOT_FOUND;
+
+    /* Fast path: AVX2-optimized linear search for small arrays */
+    if (n < 32) {
+        return not_stisla_chunked_search(arr, n, key);
+    }
+
+    /* Out-of-range keys never need a model */
+    if (key < arr[0] || key > arr[n - 1]) return NOT_STISLA_NOT_FOUND;
+    NOT_STISLA_TRACE_POINT(BEGIN, key, 0, n, NOT_STISLA_NOT_FOUND);
+
+    /* One-off searches interpolate between the endpoints only */
+    if (!table) {
+        const not_stisla_anchor_t endpoints[2] = { { .v = arr[0], .i = 0 }, { .v = arr[n - 1], .i = n - 1 } };
+        not_stisla_probe_t probe;
+        const size_t result = not_stisla_segment_search(arr, endpoints, 2, 0, &not_stisla_identity_transform, key,
+                                                        tol, &probe);
+        NOT_STISLA_TRACE_POINT(END, key, probe.pred, probe.window, result);
+        return result;
+    }
+
+    /* Initialize endpoints if needed */
+    if (table->size == 0) {
+        if (table->capacity < 2) {
+            const size_t grow = (2 - table->capacity) * NOT_STISLA_SLOT_BYTES;
+            if (!not_stisla_pool_reserve(table->pool, grow)) {
+                atomic_fetch_add(&table->pool->denied, 1);
+                return NOT_STISLA_NOT_FOUND;
+            }
+            not_stisla_anchor_t* anchors = realloc(table->anchors, 2 * NOT_STISLA_SLOT_BYTES);
+            if (!anchors) {
+                not_stisla_pool_release(table->pool, grow);
+                return NOT_STISLA_NOT_FOUND;
+            }
+            table->anchors = anchors;
+            table->capacity = 2;
+        }
+        memset(table->anchors, 0, 2 * sizeof(not_stisla_anchor_t));
+        table->anchors[0].v = arr[0];
+        table->anchors[0].i = 0;
+        table->anchors[1].v = arr[n - 1];
+        table->anchors[1].i = n - 1;
+        table->size = 2;
+        not_stisla_table_sync_keys(table);
+
+        /* Log/sqrt transforms selected before any data was seen start at the first key */
+        not_stisla_transform_prepare(&table->transform, arr[0]);
+        not_stisla_segment_reset(&table->anchors[0], &table->anchors[1], arr, &table->transform, table->interp_mode);
+    }
 
-    /* Step 4: Smart learning */
-    if (result != NOT_STISLA_NOT_FOUND && table) {
-        not_stisla_learn_anchor(table, arr[result], result, pred, tol);
+    not_stisla_probe_t probe;
+    const size_t result = not_stisla_segment_search(arr, table->anchors, table->size,
+                                                    not_stisla_table_lower(table, key), &table->transform, key,
+                                                    tol, &probe);
+
+    table->lookups++;
+    table->window_keys += probe.window;
+    table->escalations += probe.escalated;
+
+    /* Smart learning: widen the segment's observed bound, then maybe split it */
+    if (result != NOT_STISLA_NOT_FOUND) {
+        not_stisla_anchor_t* seg = &table->anchors[probe.seg];
+        if (!(seg->flags & NOT_STISLA_SEG_BOUNDED)) {
+            /* A present key off the direct address disproves the progression hint */
+            if (!probe.direct) seg->flags &= ~NOT_STISLA_SEG_EXACT;
+
+            const size_t diff = (probe.pred > result) ? (probe.pred - result) : (result - probe.pred);
+            const uint32_t err = diff >= UINT32_MAX ? UINT32_MAX : (uint32_t)diff;
+            if (probe.pred > result && err > seg->err_lo) seg->err_lo = err;
+            if (result > probe.pred && err > seg->err_hi) seg->err_hi = err;
+
+            /* Auto mode: a restarted segment chooses its predictor now that
+             * the keys are at hand; a bent one relearns its bounds */
+            if (seg->flags & NOT_STISLA_SEG_UNPROBED) {
+                not_stisla_segment_choose(seg, seg + 1, arr, &table->transform);
+                if (seg->flags & NOT_STISLA_SEG_CURVED) {
+                    seg->err_lo = 0;
+                    seg->err_hi = 0;
+                }
+            }
+        }
+        not_stisla_learn_anchor(table, arr, arr[result], result, probe.pred, tol);
         table->searches_performed++;
+        NOT_STISLA_TRACE_POINT(LEARN, key, probe.pred, probe.window, result);
     }
+    NOT_STISLA_TRACE_POINT(END, key, probe.pred, probe.window, result);
 
     return result;
 }
 
 /* Public API implementations */
-not_stisla_anchor_table_t* not_stisla_anchor_table_create(void) {
-    not_stisla_anchor_table_t* table = calloc(1, sizeof(not_stisla_anchor_table_t));
-    if (!table) return NULL;
+not_stisla_pool_t* not_stisla_pool_create(size_t budget_bytes) {
+    not_stisla_pool_t* pool = calloc(1, sizeof(not_stisla_pool_t));
+    if (!pool) return NULL;
+    atomic_store(&pool->budget, budget_bytes);
+    return pool;
+}
 
-    /* Pre-allocate for common case */
-    table->anchors = malloc(8 * sizeof(not_stisla_anchor_t));
+void not_stisla_pool_destroy(not_stisla_pool_t* pool) {
+    if (pool && pool != &not_stisla_default_pool) free(pool);
+}
+
+not_stisla_pool_t* not_stisla_pool_default(void) {
+    return &not_stisla_default_pool;
+}
+
+void not_stisla_pool_set_budget(not_stisla_pool_t* pool, size_t budget_bytes) {
+    if (!pool) pool = &not_stisla_default_pool;
+    atomic_store(&pool->budget, budget_bytes);
+}
+
+void not_stisla_pool_get_stats(const not_stisla_pool_t* pool, not_stisla_pool_stats_t* stats) {
+    if (!stats) return;
+    if (!pool) pool = &not_stisla_default_pool;
+    not_stisla_pool_t* p = (not_stisla_pool_t*)pool;  /* Atomic loads take non-const pointers */
+    stats->budget_bytes = atomic_load(&p->budget);
+    stats->used_bytes = atomic_load(&p->used);
+    stats->peak_bytes = atomic_load(&p->peak);
+    stats->tables = atomic_load(&p->tables);
+    stats->denied_growths = atomic_load(&p->denied);
+    stats->downgrades = atomic_load(&p->downgrades);
+}
+
+not_stisla_anchor_table_t* not_stisla_anchor_table_create_in(not_stisla_pool_t* pool) {
+    if (!pool) pool = &not_stisla_default_pool;
+
+    /* Pre-allocate for common case; a tight budget starts at the two endpoints */
+    size_t capacity = 8;
+    if (!not_stisla_pool_reserve(pool, sizeof(not_stisla_anchor_table_t) + capacity * NOT_STISLA_SLOT_BYTES)) {
+        capacity = 2;
+        if (!not_stisla_pool_reserve(pool,
+                                     sizeof(not_stisla_anchor_table_t) + capacity * NOT_STISLA_SLOT_BYTES)) {
+            atomic_fetch_add(&pool->denied, 1);
+            return NULL;
+        }
+        atomic_fetch_add(&pool->downgrades, 1);
+    }
+    const size_t charged = sizeof(not_stisla_anchor_table_t) + capacity * NOT_STISLA_SLOT_BYTES;
+
+    not_stisla_anchor_table_t* table = calloc(1, sizeof(not_stisla_anchor_table_t));
+    if (!table) {
+        not_stisla_pool_release(pool, charged);
+        return NULL;
+    }
+    table->anchors = malloc(capacity * NOT_STISLA_SLOT_BYTES);
     if (!table->anchors) {
+        not_stisla_pool_release(pool, charged);
         free(table);
         return NULL;
     }
-    table->capacity = 8;
+    table->capacity = capacity;
+    table->pool = pool;
     table->workload_type = -1;
+    table->interp_mode = NOT_STISLA_INTERP_LINEAR;
+    atomic_fetch_add(&pool->tables, 1);
 
     return table;
 }
 
+not_stisla_anchor_table_t* not_stisla_anchor_table_create(void) {
+    return not_stisla_anchor_table_create_in(NULL);
+}
+
 void not_stisla_anchor_table_destroy(not_stisla_anchor_table_t* table) {
     if (table) {
+        not_stisla_pool_release(table->pool,
+                                sizeof(not_stisla_anchor_table_t) + table->capacity * NOT_STISLA_SLOT_BYTES);
+        atomic_fetch_sub(&table->pool->tables, 1);
         free(table->anchors);
         free(table);
     }
 }
 
+size_t not_stisla_anchor_table_trim(not_stisla_anchor_table_t* table) {
+    if (!table || table->capacity <= table->size || table->size < 2) return 0;
+
+    not_stisla_anchor_t* anchors = realloc(table->anchors, table->size * NOT_STISLA_SLOT_BYTES);
+    if (!anchors) return 0;
+    const size_t freed = (table->capacity - table->size) * NOT_STISLA_SLOT_BYTES;
+    table->anchors = anchors;
+    table->capacity = table->size;
+    not_stisla_table_sync_keys(table);
+    not_stisla_pool_release(table->pool, freed);
+    return freed;
+}
+
 size_t not_stisla_anchor_table_size(const not_stisla_anchor_table_t* table) {
     return table ? table->size : 0;
 }
@@ -336,6 +774,9 @@ void not_stisla_anchor_table_reset(not_stisla_anchor_table_t* table) {
     if (table) {
         table->size = 0;
         table->searches_performed = 0;
+        table->lookups = 0;
+        table->escalations = 0;
+        table->window_keys = 0;
     }
 }
 
@@ -360,9 +801,155 @@ void not_stisla_get_stats(const not_stisla_anchor_table_t* table, size_t* search
     if (anchors_learned) *anchors_learned = table ? table->size : 0;
     if (memory_used_bytes) {
         *memory_used_bytes = table ?
-            (table->capacity * sizeof(not_stisla_anchor_t) + sizeof(not_stisla_anchor_table_t)) : 0;
+            (table->capacity * NOT_STISLA_SLOT_BYTES + sizeof(not_stisla_anchor_table_t)) : 0;
     }
 }
+void not_stisla_get_search_stats(const not_stisla_anchor_table_t* table, not_stisla_search_stats_t* stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (!table) return;
+
+    stats->searches = table->searches_performed;
+    stats->lookups = table->lookups;
+    stats->escalations = table->escalations;
+    stats->window_keys = table->window_keys;
+    stats->anchors = table->size;
+    for (size_t a = 0; a + 1 < table->size; ++a) {
+        stats->bounded_segments += (table->anchors[a].flags & NOT_STISLA_SEG_BOUNDED) != 0;
+        stats->curved_segments += (table->anchors[a].flags & NOT_STISLA_SEG_CURVED) != 0;
+        stats->exact_segments += (table->anchors[a].flags & NOT_STISLA_SEG_EXACT) != 0;
+    }
+}
+
+/* After a predictor change every segment restarts unmeasured */
+static void not_stisla_table_unmeasure(not_stisla_anchor_table_t* table) {
+    for (size_t a = 0; a < table->size; ++a) {
+        table->anchors[a].tv = not_stisla_transform_apply(&table->transform, table->anchors[a].v);
+        table->anchors[a].err_lo = 0;
+        table->anchors[a].err_hi = 0;
+        table->anchors[a].flags = (table->interp_mode == NOT_STISLA_INTERP_THREE_POINT) ? NOT_STISLA_SEG_CURVED : 0;
+        if (table->interp_mode == NOT_STISLA_INTERP_AUTO) table->anchors[a].flags = NOT_STISLA_SEG_UNPROBED;
+        if (a + 1 < table->size && not_stisla_segment_progression_hint(&table->anchors[a], &table->anchors[a + 1])) {
+            table->anchors[a].flags |= NOT_STISLA_SEG_EXACT;
+        }
+    }
+}
+
+bool not_stisla_set_interpolation(not_stisla_anchor_table_t* table, not_stisla_interp_mode_t mode) {
+    if (!table) return false;
+    if (mode != NOT_STISLA_INTERP_LINEAR && mode != NOT_STISLA_INTERP_THREE_POINT &&
+        mode != NOT_STISLA_INTERP_AUTO) {
+        return false;
+    }
+
+    table->interp_mode = mode;
+    not_stisla_table_unmeasure(table);
+    return true;
+}
+
+static double not_stisla_transform_error(const not_stisla_transform_t* xf, const int64_t* arr, size_t n);
+
+/* Fit transform parameters from rank-spaced keys */
+static void not_stisla_transform_fit(not_stisla_transform_t* xf, not_stisla_transform_kind_t kind,
+                                     const int64_t* arr, size_t n) {
+    memset(xf, 0, sizeof(*xf));
+    xf->kind = kind;
+    not_stisla_transform_origin(xf, arr[0]);
+
+    /* Log/sqrt: pick the offset whose curve is straightest over the sample */
+    if (kind == NOT_STISLA_TRANSFORM_LOG || kind == NOT_STISLA_TRANSFORM_SQRT) {
+        not_stisla_transform_t candidate = *xf;
+        double best_err = not_stisla_transform_error(xf, arr, n);
+        for (int k = 0; k < 63; ++k) {
+            candidate.shift = ldexp(1.0, k);
+            const double err = not_stisla_transform_error(&candidate, arr, n);
+            if (err < best_err) {
+                best_err = err;
+                xf->shift = candidate.shift;
+            }
+        }
+        xf->fitted = true;
+    }
+
+    if (kind == NOT_STISLA_TRANSFORM_PIECEWISE) {
+        const size_t knots = n < NOT_STISLA_TRANSFORM_KNOTS ? n : NOT_STISLA_TRANSFORM_KNOTS;
+        for (size_t k = 0; k < knots; ++k) {
+            const size_t rank = (size_t)(((__int128)k * (n - 1)) / (knots - 1));
+            xf->knot_keys[k] = arr[rank];
+            xf->knot_ranks[k] = (double)rank;
+        }
+        xf->knots = knots;
+    }
+}
+
+/* Straightness of the transformed keys at several anchor spacings: mean rank
+ * error of segment-local lines, relative to segment length, summed over 1, 8
+ * and 64 equal-rank segments. Samples sit between rank-spaced knots. */
+static double not_stisla_transform_error(const not_stisla_transform_t* xf, const int64_t* arr, size_t n) {
+    const size_t samples = n < NOT_STISLA_TRANSFORM_SAMPLE ? n : NOT_STISLA_TRANSFORM_SAMPLE;
+    double total = 0.0;
+
+    for (size_t segs = 1; segs <= 64; segs *= 8) {
+        for (size_t s = 0; s < samples; ++s) {
+            const size_t rank = (size_t)(((__int128)(2 * s + 1) * (n - 1)) / (2 * samples));
+            const size_t seg = (size_t)(((__int128)rank * segs) / n);
+            const size_t lo = (size_t)(((__int128)seg * (n - 1)) / segs);
+            const size_t hi = (size_t)(((__int128)(seg + 1) * (n - 1)) / segs);
+
+            const double t0 = not_stisla_transform_apply(xf, arr[lo]);
+            const double t1 = not_stisla_transform_apply(xf, arr[hi]);
+            if (!(t1 > t0)) continue;
+
+            const double pred = (double)lo + (not_stisla_transform_apply(xf, arr[rank]) - t0) / (t1 - t0) *
+                                (double)(hi - lo);
+            total += fabs(pred - (double)rank) / (double)(hi - lo);
+        }
+    }
+    return total / (double)samples;
+}
+
+bool not_stisla_set_transform(not_stisla_anchor_table_t* table, not_stisla_transform_kind_t kind,
+                              const int64_t* arr, size_t n) {
+    if (!table || kind < NOT_STISLA_TRANSFORM_NONE || kind > NOT_STISLA_TRANSFORM_PIECEWISE) return false;
+
+    if (arr && n >= 2) {
+        not_stisla_transform_fit(&table->transform, kind, arr, n);
+    } else if (kind == NOT_STISLA_TRANSFORM_PIECEWISE) {
+        return false;
+    } else {
+        /* Origin is taken from the first key at endpoint initialization */
+        memset(&table->transform, 0, sizeof(table->transform));
+        table->transform.kind = kind;
+        if (table->size > 0) not_stisla_transform_origin(&table->transform, table->anchors[0].v);
+    }
+
+    not_stisla_table_unmeasure(table);
+    return true;
+}
+
+not_stisla_transform_kind_t not_stisla_fit_transform(not_stisla_anchor_table_t* table, const int64_t* arr, size_t n) {
+    if (!table || !arr || n < 2) return table ? table->transform.kind : NOT_STISLA_TRANSFORM_NONE;
+
+    not_stisla_transform_kind_t best = NOT_STISLA_TRANSFORM_NONE;
+    double best_err = 0.0;
+    for (int kind = NOT_STISLA_TRANSFORM_NONE; kind <= NOT_STISLA_TRANSFORM_PIECEWISE; ++kind) {
+        not_stisla_transform_t candidate;
+        not_stisla_transform_fit(&candidate, (not_stisla_transform_kind_t)kind, arr, n);
+        double err = not_stisla_transform_error(&candidate, arr, n);
+
+        /* The piecewise transform costs a knot search per query; demand a clear win */
+        if (kind == NOT_STISLA_TRANSFORM_PIECEWISE) err *= 2.0;
+
+        if (kind == NOT_STISLA_TRANSFORM_NONE || err < best_err) {
+            best = (not_stisla_transform_kind_t)kind;
+            best_err = err;
+        }
+    }
+
+    not_stisla_set_transform(table, best, arr, n);
+    return best;
+}
+
 not_stisla_result_t not_stisla_search_telemetry(const int64_t* timestamps, size_t n,
                                        int64_t target_time, not_stisla_anchor_table_t* table) {
     /* Telemetry optimization: higher tolerance for variable gaps */
@@ -393,9 +980,1025 @@ bool not_stisla_init_for_dsmil(not_stisla_anchor_table_t* table, int workload_ty
     table->workload_type = workload_type;
     not_stisla_anchor_table_reset(table);
 
+    /* Offsets grow exponentially: interpolate them in log space */
+    memset(&table->transform, 0, sizeof(table->transform));
+    table->transform.kind = (workload_type == NOT_STISLA_WORKLOAD_OFFSETS) ?
+        NOT_STISLA_TRANSFORM_LOG : NOT_STISLA_TRANSFORM_NONE;
+
     return true;
 }
 
+/* Whether every key of the segment lies on the progression through its endpoints */
+static bool not_stisla_segment_is_progression(const int64_t* arr, const not_stisla_anchor_t* l,
+                                              const not_stisla_anchor_t* r) {
+    if (!not_stisla_segment_progression_hint(l, r)) return false;
+    const uint64_t stride = ((uint64_t)r->v - (uint64_t)l->v) / (r->i - l->i);
+    for (size_t i = l->i + 1; i < r->i; ++i) {
+        if ((uint64_t)arr[i] - (uint64_t)arr[i - 1] != stride) return false;
+    }
+    return true;
+}
+
+/* Exact left/right prediction error over every key of one segment */
+static void not_stisla_segment_measure(const int64_t* arr, const not_stisla_transform_t* xf, not_stisla_anchor_t* l,
+                                       const not_stisla_anchor_t* r) {
+    size_t lo_err = 0;
+    size_t hi_err = 0;
+    for (size_t i = l->i; i <= r->i; ++i) {
+        const size_t pred = not_stisla_predict(xf, l, r, arr[i]);
+        if (pred > i && pred - i > lo_err) lo_err = pred - i;
+        if (i > pred && i - pred > hi_err) hi_err = i - pred;
+    }
+    l->err_lo = lo_err >= UINT32_MAX ? UINT32_MAX : (uint32_t)lo_err;
+    l->err_hi = hi_err >= UINT32_MAX ? UINT32_MAX : (uint32_t)hi_err;
+    l->flags |= NOT_STISLA_SEG_BOUNDED;
+    if (not_stisla_segment_is_progression(arr, l, r)) {
+        l->flags |= NOT_STISLA_SEG_EXACT;
+    } else {
+        l->flags &= ~NOT_STISLA_SEG_EXACT;
+    }
+}
+
+/* Largest prediction error inside one segment, and where it occurs */
+static size_t not_stisla_segment_max_error(const int64_t* arr, const not_stisla_transform_t* xf,
+                                           const not_stisla_anchor_t* l, const not_stisla_anchor_t* r,
+                                           size_t* worst_at) {
+    size_t worst = 0;
+    *worst_at = l->i;
+    for (size_t i = l->i + 1; i < r->i; ++i) {
+        const size_t pred = not_stisla_predict(xf, l, r, arr[i]);
+        const size_t diff = (pred > i) ? (pred - i) : (i - pred);
+        if (diff > worst) {
+            worst = diff;
+            *worst_at = i;
+        }
+    }
+    return worst;
+}
+
+/* Prepare a built segment; auto mode keeps whichever predictor has the smaller worst error */
+static size_t not_stisla_segment_fit(const int64_t* arr, const not_stisla_transform_t* xf, not_stisla_anchor_t* l,
+                                     not_stisla_anchor_t* r, not_stisla_interp_mode_t mode, size_t* worst_at) {
+    not_stisla_segment_reset(l, r, arr, xf, mode == NOT_STISLA_INTERP_AUTO ? NOT_STISLA_INTERP_LINEAR : mode);
+    size_t worst = not_stisla_segment_max_error(arr, xf, l, r, worst_at);
+
+    if (mode == NOT_STISLA_INTERP_AUTO && worst > 0) {
+        size_t curved_at;
+        l->flags |= NOT_STISLA_SEG_CURVED;
+        const size_t curved = not_stisla_segment_max_error(arr, xf, l, r, &curved_at);
+        if (curved < worst) {
+            worst = curved;
+            *worst_at = curved_at;
+        } else {
+            l->flags &= ~NOT_STISLA_SEG_CURVED;
+        }
+    }
+    return worst;
+}
+
+/* Build error of a segment; progression segments are answered by direct
+ * address, so whatever their predictor, they need no further split */
+static size_t not_stisla_segment_build_error(const int64_t* arr, const not_stisla_transform_t* xf,
+                                             not_stisla_anchor_t* l, not_stisla_anchor_t* r,
+                                             not_stisla_interp_mode_t mode, size_t* worst_at) {
+    const size_t err = not_stisla_segment_fit(arr, xf, l, r, mode, worst_at);
+    return (err && not_stisla_segment_is_progression(arr, l, r)) ? 0 : err;
+}
+
+/* Append an anchor unless its key would not be strictly between the last one and the final key */
+static inline void not_stisla_run_anchor(const int64_t* arr, size_t n, not_stisla_anchor_t* anchors, size_t* size,
+                                         size_t i) {
+    if (arr[i] <= anchors[*size - 1].v || arr[i] >= arr[n - 1]) return;
+    anchors[*size].v = arr[i];
+    anchors[*size].i = i;
+    (*size)++;
+}
+
+/* Initial build anchors: both array ends, plus both ends of every arithmetic
+ * progression of at least NOT_STISLA_EXACT_MIN_RUN keys while fewer than
+ * 'limit' anchors are placed. Runs sharing a boundary key share its anchor. */
+static size_t not_stisla_run_anchors(const int64_t* arr, size_t n, not_stisla_anchor_t* anchors, size_t limit) {
+    size_t size = 1;
+    anchors[0].v = arr[0];
+    anchors[0].i = 0;
+
+    size_t start = 0;
+    for (size_t i = 1; i <= n; ++i) {
+        /* Key i extends the run if it steps up by the run's stride */
+        if (i < n && arr[i] > arr[i - 1]) {
+            const uint64_t step = (uint64_t)arr[i] - (uint64_t)arr[i - 1];
+            if (i - start == 1 || step == (uint64_t)arr[start + 1] - (uint64_t)arr[start]) continue;
+        }
+        if (i - start >= NOT_STISLA_EXACT_MIN_RUN && size + 2 <= limit) {
+            not_stisla_run_anchor(arr, n, anchors, &size, start);
+            not_stisla_run_anchor(arr, n, anchors, &size, i - 1);
+        }
+        if (i < n) start = (arr[i] > arr[i - 1]) ? i - 1 : i;
+    }
+
+    anchors[size].v = arr[n - 1];
+    anchors[size].i = n - 1;
+    return size + 1;
+}
+
+bool not_stisla_anchor_table_build(not_stisla_anchor_table_t* table, const int64_t* arr, size_t n,
+                                   size_t max_anchors, size_t tol) {
+    if (!table || !arr || n < 2) return false;
+    if (max_anchors == 0) max_anchors = NOT_STISLA_BUILD_MAX_ANCHORS;
+    if (max_anchors < 2) max_anchors = 2;
+
+    /* Over budget the build gets fewer anchors */
+    max_anchors = not_stisla_pool_reserve_anchors(table, max_anchors);
+    if (max_anchors == 0) return false;
+
+    /* Per-segment worst error, indexed like the left anchor of each segment */
+    size_t* seg_err = malloc(max_anchors * sizeof(size_t));
+    size_t* seg_at = malloc(max_anchors * sizeof(size_t));
+    not_stisla_anchor_t* anchors = malloc(max_anchors * NOT_STISLA_SLOT_BYTES);
+    if (!seg_err || !seg_at || !anchors) {
+        free(seg_err);
+        free(seg_at);
+        free(anchors);
+        not_stisla_pool_unreserve_anchors(table, max_anchors);
+        return false;
+    }
+
+    /* Long progressions take up to half the budget and become exact segments */
+    memset(anchors, 0, max_anchors * sizeof(not_stisla_anchor_t));
+    size_t size = not_stisla_run_anchors(arr, n, anchors, max_anchors / 2);
+    const not_stisla_interp_mode_t mode = table->interp_mode;
+    not_stisla_transform_t* xf = &table->transform;
+    not_stisla_transform_prepare(xf, arr[0]);
+    for (size_t a = 0; a + 1 < size; ++a) {
+        seg_err[a] = not_stisla_segment_build_error(arr, xf, &anchors[a], &anchors[a + 1], mode, &seg_at[a]);
+    }
+
+    /* Greedily split the worst segment at its worst key */
+    while (size < max_anchors) {
+        size_t worst = 0;
+        for (size_t s = 1; s + 1 < size; ++s) {
+            if (seg_err[s] > seg_err[worst]) worst = s;
+        }
+        if (seg_err[worst] <= tol) break;
+
+        const size_t at = seg_at[worst];
+        if (arr[at] == anchors[worst].v || arr[at] == anchors[worst + 1].v) {
+            /* Duplicate run: no anchor can separate it */
+            seg_err[worst] = 0;
+            continue;
+        }
+
+        memmove(&anchors[worst + 2], &anchors[worst + 1], (size - worst - 1) * sizeof(not_stisla_anchor_t));
+        memmove(&seg_err[worst + 2], &seg_err[worst + 1], (size - worst - 2) * sizeof(size_t));
+        memmove(&seg_at[worst + 2], &seg_at[worst + 1], (size - worst - 2) * sizeof(size_t));
+        anchors[worst + 1].v = arr[at];
+        anchors[worst + 1].i = at;
+        size++;
+
+        seg_err[worst] = not_stisla_segment_build_error(arr, xf, &anchors[worst], &anchors[worst + 1], mode,
+                                                        &seg_at[worst]);
+        seg_err[worst + 1] = not_stisla_segment_build_error(arr, xf, &anchors[worst + 1], &anchors[worst + 2], mode,
+                                                            &seg_at[worst + 1]);
+    }
+
+    free(seg_err);
+    free(seg_at);
+
+    /* Built segments get exact bounds, so searches never escalate */
+    for (size_t a = 0; a + 1 < size; ++a) {
+        not_stisla_segment_measure(arr, xf, &anchors[a], &anchors[a + 1]);
+    }
+
+    free(table->anchors);
+    table->anchors = anchors;
+    table->capacity = max_anchors;
+    table->size = size;
+    not_stisla_table_sync_keys(table);
+    table->searches_performed = 0;
+    table->lookups = 0;
+    table->escalations = 0;
+    table->window_keys = 0;
+
+    return true;
+}
+
+bool not_stisla_anchor_table_seed(not_stisla_anchor_table_t* table, const int64_t* arr, size_t n,
+                                  size_t max_anchors, size_t tol) {
+    if (!table || !arr || n < 2) return false;
+    if (max_anchors == 0) max_anchors = not_stisla_workload_max_anchors(table->workload_type);
+    if (max_anchors < 2) max_anchors = 2;
+
+    max_anchors = not_stisla_pool_reserve_anchors(table, max_anchors);
+    if (max_anchors == 0) return false;
+
+    size_t* seg_err = malloc(max_anchors * sizeof(size_t));
+    size_t* seg_at = malloc(max_anchors * sizeof(size_t));
+    not_stisla_anchor_t* anchors = calloc(max_anchors, NOT_STISLA_SLOT_BYTES);
+    if (!seg_err || !seg_at || !anchors) {
+        free(seg_err);
+        free(seg_at);
+        free(anchors);
+        not_stisla_pool_unreserve_anchors(table, max_anchors);
+        return false;
+    }
+
+    anchors[0].v = arr[0];
+    anchors[0].i = 0;
+    anchors[1].v = arr[n - 1];
+    anchors[1].i = n - 1;
+    size_t size = 2;
+    const not_stisla_interp_mode_t mode = table->interp_mode;
+    not_stisla_transform_t* xf = &table->transform;
+    not_stisla_transform_prepare(xf, arr[0]);
+    not_stisla_segment_reset(&anchors[0], &anchors[1], arr, xf, mode);
+    seg_err[0] = not_stisla_segment_probe_error(arr, xf, &anchors[0], &anchors[1], &seg_at[0]);
+
+    /* Split the segment with the worst probe error at that probe; each split
+     * costs O(1) key reads, so seeding is independent of n */
+    while (size < max_anchors) {
+        size_t worst = 0;
+        for (size_t s = 1; s + 1 < size; ++s) {
+            if (seg_err[s] > seg_err[worst]) worst = s;
+        }
+        if (seg_err[worst] <= tol) break;
+
+        const size_t at = seg_at[worst];
+        if (arr[at] == anchors[worst].v || arr[at] == anchors[worst + 1].v) {
+            seg_err[worst] = 0;
+            continue;
+        }
+
+        memmove(&anchors[worst + 2], &anchors[worst + 1], (size - worst - 1) * sizeof(not_stisla_anchor_t));
+        memmove(&seg_err[worst + 2], &seg_err[worst + 1], (size - worst - 2) * sizeof(size_t));
+        memmove(&seg_at[worst + 2], &seg_at[worst + 1], (size - worst - 2) * sizeof(size_t));
+        anchors[worst + 1].v = arr[at];
+        anchors[worst + 1].i = at;
+        size++;
+
+        not_stisla_segment_reset(&anchors[worst], &anchors[worst + 1], arr, xf, mode);
+        not_stisla_segment_reset(&anchors[worst + 1], &anchors[worst + 2], arr, xf, mode);
+        seg_err[worst] = not_stisla_segment_probe_error(arr, xf, &anchors[worst], &anchors[worst + 1],
+                                                        &seg_at[worst]);
+        seg_err[worst + 1] = not_stisla_segment_probe_error(arr, xf, &anchors[worst + 1], &anchors[worst + 2],
+                                                            &seg_at[worst + 1]);
+    }
+
+    free(seg_err);
+    free(seg_at);
+
+    /* Seeded segments stay unmeasured: searches learn their bounds and keep splitting */
+    free(table->anchors);
+    table->anchors = anchors;
+    table->capacity = max_anchors;
+    table->size = size;
+    not_stisla_table_sync_keys(table);
+    table->searches_performed = 0;
+    table->lookups = 0;
+    table->escalations = 0;
+    table->window_keys = 0;
+
+    return true;
+}
+
+/* Live index: immutable snapshots swapped in by a background rebuild thread */
+typedef struct {
+    const int64_t* arr;
+    size_t n;
+    not_stisla_anchor_table_t* table;
+    size_t generation;
+    size_t mean_error;  /* Build-time mean prediction error, rounded up */
+} not_stisla_live_snapshot_t;
+
+struct not_stisla_live {
+    _Atomic(not_stisla_live_snapshot_t*) current;
+
+    /* Two-phase reader registration for snapshot reclamation */
+    atomic_uint epoch;
+    _Alignas(64) atomic_size_t readers[2];
+
+    /* Sampled prediction error of the current snapshot */
+    _Alignas(64) atomic_size_t err_sum;
+    atomic_size_t err_samples;
+    atomic_bool auto_requested;
+    atomic_size_t err_threshold;
+    atomic_size_t min_samples;
+    atomic_uint auto_backoff;  /* Doubles the samples needed after each rebuild that changed nothing */
+
+    size_t tol;
+    size_t max_anchors;
+
+    /* Rebuild requests, protected by lock */
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_cond_t idle;
+    const int64_t* req_arr;
+    size_t req_n;
+    size_t req_seq;
+    size_t done_seq;
+    size_t published_seq;  /* Last request whose model was swapped in */
+    bool stop;
+    pthread_t worker;
+};
+
+/* Mean prediction error of a table over every key, rounded up */
+static size_t not_stisla_live_model_error(const not_stisla_anchor_table_t* t, const int64_t* arr, size_t n) {
+    size_t err_total = 0;
+    for (size_t a = 0; a + 1 < t->size; ++a) {
+        const not_stisla_anchor_t* l = &t->anchors[a];
+        const not_stisla_anchor_t* r = &t->anchors[a + 1];
+        for (size_t i = l->i + 1; i < r->i && i < n; ++i) {
+            const size_t pred = not_stisla_predict(&t->transform, l, r, arr[i]);
+            err_total += (pred > i) ? (pred - i) : (i - pred);
+        }
+    }
+    return n ? (err_total + n - 1) / n : 0;
+}
+
+static not_stisla_live_snapshot_t* not_stisla_live_build(const int64_t* arr, size_t n, size_t tol,
+                                                         size_t max_anchors, size_t generation) {
+    not_stisla_live_snapshot_t* snap = malloc(sizeof(not_stisla_live_snapshot_t));
+    if (!snap) return NULL;
+
+    snap->table = not_stisla_anchor_table_create();
+    if (!snap->table || (n >= 2 && !not_stisla_anchor_table_build(snap->table, arr, n, max_anchors, tol))) {
+        not_stisla_anchor_table_destroy(snap->table);
+        free(snap);
+        return NULL;
+    }
+    snap->arr = arr;
+    snap->n = n;
+    snap->generation = generation;
+
+    /* Baseline error, so automatic rebuilds only fire when they can help */
+    snap->mean_error = not_stisla_live_model_error(snap->table, arr, n);
+
+    return snap;
+}
+
+static void not_stisla_live_snapshot_free(not_stisla_live_snapshot_t* snap) {
+    if (snap) {
+        not_stisla_anchor_table_destroy(snap->table);
+        free(snap);
+    }
+}
+
+/* Swap in a new snapshot and free the old one once no reader can hold it */
+static void not_stisla_live_publish(not_stisla_live_t* live, not_stisla_live_snapshot_t* snap) {
+    not_stisla_live_snapshot_t* old = atomic_exchange(&live->current, snap);
+
+    atomic_store(&live->err_sum, 0);
+    atomic_store(&live->err_samples, 0);
+    atomic_store(&live->auto_backoff, 0);
+    atomic_store(&live->auto_requested, false);
+
+    const unsigned e = atomic_fetch_add(&live->epoch, 1);
+    while (atomic_load(&live->readers[e & 1]) != 0) {
+        sched_yield();
+    }
+
+    not_stisla_live_snapshot_free(old);
+}
+
+static void* not_stisla_live_worker(void* arg) {
+    not_stisla_live_t* live = arg;
+
+    pthread_mutex_lock(&live->lock);
+    while (!live->stop) {
+        const bool explicit_req = live->done_seq != live->req_seq;
+        if (!explicit_req && !atomic_load(&live->auto_requested)) {
+            struct timespec deadline;
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_nsec += NOT_STISLA_LIVE_POLL_NS;
+            if (deadline.tv_nsec >= 1000000000L) {
+                deadline.tv_sec++;
+                deadline.tv_nsec -= 1000000000L;
+            }
+            pthread_cond_timedwait(&live->wake, &live->lock, &deadline);
+            continue;
+        }
+
+        /* Explicit requests win; automatic ones rebuild the current array */
+        const not_stisla_live_snapshot_t* cur = atomic_load(&live->current);
+        const int64_t* arr = explicit_req ? live->req_arr : cur->arr;
+        const size_t n = explicit_req ? live->req_n : cur->n;
+        const size_t seq = live->req_seq;
+        const size_t generation = cur->generation + 1;
+        pthread_mutex_unlock(&live->lock);
+
+        not_stisla_live_snapshot_t* snap = not_stisla_live_build(arr, n, live->tol, live->max_anchors, generation);
+
+        /* An automatic rebuild of unchanged keys reproduces the same model:
+         * keep the current one and wait longer before sampling again */
+        if (snap && !explicit_req && snap->mean_error >= not_stisla_live_model_error(cur->table, arr, n)) {
+            not_stisla_live_snapshot_free(snap);
+            snap = NULL;
+            const unsigned backoff = atomic_load(&live->auto_backoff);
+            if (backoff < NOT_STISLA_LIVE_MAX_BACKOFF) atomic_store(&live->auto_backoff, backoff + 1);
+            atomic_store(&live->err_sum, 0);
+            atomic_store(&live->err_samples, 0);
+        }
+        if (snap) {
+            not_stisla_live_publish(live, snap);
+        } else {
+            atomic_store(&live->auto_requested, false);
+        }
+
+        pthread_mutex_lock(&live->lock);
+        if (explicit_req) {
+            live->done_seq = seq;
+            if (snap) live->published_seq = seq;
+            pthread_cond_broadcast(&live->idle);
+        }
+    }
+    pthread_mutex_unlock(&live->lock);
+
+    return NULL;
+}
+
+not_stisla_live_t* not_stisla_live_create(const int64_t* arr, size_t n, size_t tol, size_t max_anchors) {
+    if (!arr && n > 0) return NULL;
+
+    not_stisla_live_t* live = calloc(1, sizeof(not_stisla_live_t));
+    if (!live) return NULL;
+
+    live->tol = tol;
+    live->max_anchors = max_anchors;
+
+    /* First build is synchronous so no query ever runs on a cold model */
+    not_stisla_live_snapshot_t* snap = not_stisla_live_build(arr, n, tol, max_anchors, 0);
+    if (!snap) {
+        free(live);
+        return NULL;
+    }
+    atomic_init(&live->current, snap);
+    atomic_init(&live->epoch, 0);
+    atomic_init(&live->readers[0], 0);
+    atomic_init(&live->readers[1], 0);
+    atomic_init(&live->err_sum, 0);
+    atomic_init(&live->err_samples, 0);
+    atomic_init(&live->auto_requested, false);
+    atomic_init(&live->err_threshold, 0);
+    atomic_init(&live->min_samples, 1);
+    atomic_init(&live->auto_backoff, 0);
+
+    pthread_mutex_init(&live->lock, NULL);
+    pthread_cond_init(&live->wake, NULL);
+    pthread_cond_init(&live->idle, NULL);
+    if (pthread_create(&live->worker, NULL, not_stisla_live_worker, live) != 0) {
+        pthread_cond_destroy(&live->idle);
+        pthread_cond_destroy(&live->wake);
+        pthread_mutex_destroy(&live->lock);
+        not_stisla_live_snapshot_free(snap);
+        free(live);
+        return NULL;
+    }
+
+    return live;
+}
+
+void not_stisla_live_destroy(not_stisla_live_t* live) {
+    if (!live) return;
+
+    pthread_mutex_lock(&live->lock);
+    live->stop = true;
+    pthread_cond_signal(&live->wake);
+    pthread_mutex_unlock(&live->lock);
+    pthread_join(live->worker, NULL);
+
+    pthread_cond_destroy(&live->idle);
+    pthread_cond_destroy(&live->wake);
+    pthread_mutex_destroy(&live->lock);
+    not_stisla_live_snapshot_free(atomic_load(&live->current));
+    free(live);
+}
+
+not_stisla_result_t not_stisla_live_search(not_stisla_live_t* live, int64_t key) {
+    if (!live) return NOT_STISLA_NOT_FOUND;
+
+    /* Register as a reader of the current epoch (never blocks) */
+    unsigned slot;
+    for (;;) {
+        const unsigned e = atomic_load(&live->epoch);
+        slot = e & 1;
+        atomic_fetch_add(&live->readers[slot], 1);
+        if (atomic_load(&live->epoch) == e) break;
+        atomic_fetch_sub(&live->readers[slot], 1);
+    }
+
+    const not_stisla_live_snapshot_t* snap = atomic_load(&live->current);
+    const int64_t* arr = snap->arr;
+    const size_t n = snap->n;
+
+    size_t result = NOT_STISLA_NOT_FOUND;
+    if (n > 0 && n < 32) {
+        result = not_stisla_chunked_search(arr, n, key);
+    } else if (n > 0 && key >= arr[0] && key <= arr[n - 1]) {
+        not_stisla_probe_t probe;
+        const not_stisla_anchor_table_t* table = snap->table;
+        result = not_stisla_segment_search(arr, table->anchors, table->size, not_stisla_table_lower(table, key),
+                                           &table->transform, key, live->tol, &probe);
+        const size_t pred = probe.pred;
+
+        /* Sampled error monitoring, hashed on the key to stay branch-cheap */
+        const size_t threshold = atomic_load_explicit(&live->err_threshold, memory_order_relaxed);
+        if (result != NOT_STISLA_NOT_FOUND && threshold &&
+            (((uint64_t)key * 0x9E3779B97F4A7C15ULL) >> NOT_STISLA_LIVE_SAMPLE_SHIFT) == 0) {
+            const size_t diff = (pred > result) ? (pred - result) : (result - pred);
+            const size_t sum = atomic_fetch_add_explicit(&live->err_sum, diff, memory_order_relaxed) + diff;
+            const size_t samples = atomic_fetch_add_explicit(&live->err_samples, 1, memory_order_relaxed) + 1;
+            const size_t needed = atomic_load_explicit(&live->min_samples, memory_order_relaxed)
+                                  << atomic_load_explicit(&live->auto_backoff, memory_order_relaxed);
+            if (samples >= needed &&
+                sum > threshold * samples && snap->mean_error < threshold &&
+                !atomic_exchange(&live->auto_requested, true)) {
+                pthread_cond_signal(&live->wake);
+            }
+        }
+    }
+
+    atomic_fetch_sub(&live->readers[slot], 1);
+    return result;
+}
+
+bool not_stisla_live_rebuild(not_stisla_live_t* live, const int64_t* arr, size_t n) {
+    if (!live || (!arr && n > 0)) return false;
+
+    pthread_mutex_lock(&live->lock);
+    live->req_arr = arr;
+    live->req_n = n;
+    live->req_seq++;
+    pthread_cond_signal(&live->wake);
+    pthread_mutex_unlock(&live->lock);
+
+    return true;
+}
+
+void not_stisla_live_set_rebuild_threshold(not_stisla_live_t* live, size_t mean_error, size_t min_samples) {
+    if (!live) return;
+
+    atomic_store(&live->min_samples, min_samples ? min_samples : 1);
+    atomic_store(&live->auto_backoff, 0);
+    atomic_store(&live->err_threshold, mean_error);
+}
+
+bool not_stisla_live_wait(not_stisla_live_t* live) {
+    if (!live) return false;
+
+    pthread_mutex_lock(&live->lock);
+    const size_t target = live->req_seq;
+    while (live->done_seq < target) {
+        pthread_cond_wait(&live->idle, &live->lock);
+    }
+
+    /* A failed build leaves the previous snapshot, and its array, in service */
+    const bool published = live->published_seq >= target;
+    pthread_mutex_unlock(&live->lock);
+    return published;
+}
+
+size_t not_stisla_live_generation(not_stisla_live_t* live) {
+    if (!live) return 0;
+    return atomic_load(&live->current)->generation;
+}
+
+/* Frozen table: one flat, position-independent block.
+ * Arrays follow the header at cache-line aligned byte offsets, so the block
+ * can be copied into shared memory or a file and searched in place.
+ * Keys and indices are stored in 32 bits whenever the model allows: indices
+ * when the array has fewer than 2^32 keys, keys as offsets from key_base
+ * when the anchors span less than 2^32.
+ * Each segment keeps the predictor the table used for it: the slope, the
+ * curve through its midpoint, the table's transform, or the direct address
+ * of an arithmetic progression. Models with only linear segments carry no
+ * mode, param or tv arrays (offset 0). */
+struct not_stisla_frozen {
+    uint64_t magic;
+    uint64_t bytes;        /* Total block size */
+    uint64_t n;            /* Length of the array the model was frozen for */
+    uint64_t anchors;      /* Anchor count (segments = anchors - 1) */
+    uint64_t keys_off;     /* int64_t keys[anchors], or uint32_t offsets from key_base */
+    uint64_t idx_off;      /* uint64_t idx[anchors], or uint32_t */
+    uint64_t slope_off;    /* double   slope[segments] */
+    uint64_t err_lo_off;   /* uint32_t err_lo[segments]: max keys left of prediction */
+    uint64_t err_hi_off;   /* uint32_t err_hi[segments]: max keys right of prediction */
+    uint64_t mode_off;     /* uint8_t mode[segments], or 0 when every segment is linear */
+    uint64_t param_off;    /* int64_t param[segments]: curve midpoint key or progression stride, or 0 */
+    uint64_t tv_off;       /* double tv[anchors]: transformed anchor keys, or 0 */
+    uint64_t window_steps; /* Halvings that close the widest window: ceil(log2(max window)) */
+    int64_t key_base;      /* First anchor key; compact keys are offsets from it */
+    uint32_t key_bytes;    /* 4 or 8 */
+    uint32_t idx_bytes;    /* 4 or 8 */
+    not_stisla_transform_t transform;  /* The table's transform, for transformed segments */
+};
+
+/* Per-segment predictors of a frozen model */
+enum {
+    NOT_STISLA_FROZEN_LINEAR = 0,
+    NOT_STISLA_FROZEN_CURVED = 1,
+    NOT_STISLA_FROZEN_TRANSFORMED = 2,
+    NOT_STISLA_FROZEN_EXACT = 3
+};
+
+#define NOT_STISLA_FROZEN_ARRAY(f, type, field) ((type*)((char*)(f) + (f)->field))
+#define NOT_STISLA_FROZEN_CARRAY(f, type, field) ((const type*)((const char*)(f) + (f)->field))
+
+static inline size_t not_stisla_align_up(size_t x, size_t a) {
+    return (x + a - 1) & ~(a - 1);
+}
+
+/* Width checks are constant per model, so these branches always predict */
+static inline int64_t not_stisla_frozen_key(const not_stisla_frozen_t* f, size_t k) {
+    if (f->key_bytes == 4) {
+        return (int64_t)((uint64_t)f->key_base + NOT_STISLA_FROZEN_CARRAY(f, uint32_t, keys_off)[k]);
+    }
+    return NOT_STISLA_FROZEN_CARRAY(f, int64_t, keys_off)[k];
+}
+
+static inline size_t not_stisla_frozen_idx(const not_stisla_frozen_t* f, size_t k) {
+    if (f->idx_bytes == 4) return NOT_STISLA_FROZEN_CARRAY(f, uint32_t, idx_off)[k];
+    return (size_t)NOT_STISLA_FROZEN_CARRAY(f, uint64_t, idx_off)[k];
+}
+
+/* Frozen prediction: precomputed slope, no 128-bit division on the read path */
+static inline size_t not_stisla_frozen_predict(int64_t left_key, size_t left_idx, size_t right_idx, double slope,
+                                               int64_t key) {
+    const double delta = (double)((uint64_t)key - (uint64_t)left_key);
+    size_t pred = left_idx + (size_t)(delta * slope);
+    return pred < right_idx ? pred : right_idx;
+}
+
+/* Predict with segment s's own predictor; linear-only models skip the mode read */
+static inline size_t not_stisla_frozen_segment_predict(const not_stisla_frozen_t* f, size_t s, size_t left,
+                                                       size_t right, int64_t key) {
+    const int64_t left_key = not_stisla_frozen_key(f, s);
+    const unsigned mode = f->mode_off ? NOT_STISLA_FROZEN_CARRAY(f, uint8_t, mode_off)[s] : NOT_STISLA_FROZEN_LINEAR;
+
+    switch (mode) {
+        case NOT_STISLA_FROZEN_CURVED: {
+            const not_stisla_anchor_t l = { .v = left_key, .i = left,
+                                            .mv = NOT_STISLA_FROZEN_CARRAY(f, int64_t, param_off)[s] };
+            const not_stisla_anchor_t r = { .v = not_stisla_frozen_key(f, s + 1), .i = right };
+            return not_stisla_interpolate3(&l, &r, key);
+        }
+        case NOT_STISLA_FROZEN_TRANSFORMED: {
+            const double* tv = NOT_STISLA_FROZEN_CARRAY(f, double, tv_off);
+            const not_stisla_anchor_t l = { .i = left, .tv = tv[s] };
+            const not_stisla_anchor_t r = { .i = right, .tv = tv[s + 1] };
+            return not_stisla_interpolate_transformed(&f->transform, &l, &r, key);
+        }
+        case NOT_STISLA_FROZEN_EXACT: {
+            const uint64_t stride = (uint64_t)NOT_STISLA_FROZEN_CARRAY(f, int64_t, param_off)[s];
+            const size_t pred = left + (size_t)(((uint64_t)key - (uint64_t)left_key) / stride);
+            return pred < right ? pred : right;
+        }
+        default:
+            return not_stisla_frozen_predict(left_key, left, right, NOT_STISLA_FROZEN_CARRAY(f, double, slope_off)[s],
+                                             key);
+    }
+}
+
+/* Steps 1-3 shared by both frozen searches: segment lookup, prediction and
+ * the window sized by the segment's measured error. False if key is outside
+ * the anchors. The anchor lookup's step count depends only on the model. */
+static inline bool not_stisla_frozen_window(const not_stisla_frozen_t* f, int64_t key, size_t* lo, size_t* hi) {
+    const size_t count = f->anchors;
+    if (key < f->key_base || key > not_stisla_frozen_key(f, count - 1)) return false;
+
+    size_t s;
+    if (f->key_bytes == 4) {
+        const uint32_t x = (uint32_t)((uint64_t)key - (uint64_t)f->key_base);
+        s = not_stisla_keys_lower32(NOT_STISLA_FROZEN_CARRAY(f, uint32_t, keys_off), count, x);
+    } else {
+        s = not_stisla_keys_lower(NOT_STISLA_FROZEN_CARRAY(f, int64_t, keys_off), count, key);
+    }
+    if (s + 1 >= count) s = count - 2;
+
+    const size_t left = not_stisla_frozen_idx(f, s);
+    const size_t right = not_stisla_frozen_idx(f, s + 1);
+    const size_t pred = not_stisla_frozen_segment_predict(f, s, left, right, key);
+
+    const uint32_t e_lo = NOT_STISLA_FROZEN_CARRAY(f, uint32_t, err_lo_off)[s];
+    const uint32_t e_hi = NOT_STISLA_FROZEN_CARRAY(f, uint32_t, err_hi_off)[s];
+    *lo = (e_lo == UINT32_MAX || pred - left < e_lo) ? left : pred - e_lo;
+    *hi = (e_hi == UINT32_MAX || right - pred < e_hi) ? right : pred + e_hi;
+    return true;
+}
+
+not_stisla_frozen_t* not_stisla_freeze(const not_stisla_anchor_table_t* table, const int64_t* arr, size_t n) {
+    if (!arr || n < 2) return NULL;
+
+    /* Unlearned tables freeze to the two endpoints */
+    const not_stisla_anchor_t endpoints[2] = { { .v = arr[0], .i = 0 }, { .v = arr[n - 1], .i = n - 1 } };
+    const not_stisla_anchor_t* src = endpoints;
+    size_t count = 2;
+    if (table && table->size >= 2 && table->anchors[0].i == 0 && table->anchors[table->size - 1].i == n - 1) {
+        src = table->anchors;
+        count = table->size;
+    }
+    const size_t segments = count - 1;
+
+    /* Each segment's predictor, as the table would use it */
+    const not_stisla_transform_t* xf = table ? &table->transform : &not_stisla_identity_transform;
+    uint8_t* modes = malloc(segments);
+    if (!modes) return NULL;
+    bool any_mode = false, any_param = false, any_tv = false;
+    for (size_t s = 0; s < segments; ++s) {
+        if (not_stisla_segment_is_progression(arr, &src[s], &src[s + 1])) {
+            modes[s] = NOT_STISLA_FROZEN_EXACT;
+        } else if (src[s].flags & NOT_STISLA_SEG_CURVED) {
+            modes[s] = NOT_STISLA_FROZEN_CURVED;
+        } else if (xf->kind != NOT_STISLA_TRANSFORM_NONE) {
+            modes[s] = NOT_STISLA_FROZEN_TRANSFORMED;
+        } else {
+            modes[s] = NOT_STISLA_FROZEN_LINEAR;
+        }
+        any_mode |= modes[s] != NOT_STISLA_FROZEN_LINEAR;
+        any_param |= modes[s] == NOT_STISLA_FROZEN_CURVED || modes[s] == NOT_STISLA_FROZEN_EXACT;
+        any_tv |= modes[s] == NOT_STISLA_FROZEN_TRANSFORMED;
+    }
+
+    /* Narrowest encodings this model fits */
+    const size_t key_bytes = ((uint64_t)src[count - 1].v - (uint64_t)src[0].v <= UINT32_MAX) ? 4 : 8;
+    const size_t idx_bytes = ((uint64_t)(n - 1) <= UINT32_MAX) ? 4 : 8;
+
+    size_t off = not_stisla_align_up(sizeof(not_stisla_frozen_t), NOT_STISLA_CACHE_LINE);
+    const size_t keys_off = off;
+    off = not_stisla_align_up(off + count * key_bytes, NOT_STISLA_CACHE_LINE);
+    const size_t idx_off = off;
+    off = not_stisla_align_up(off + count * idx_bytes, NOT_STISLA_CACHE_LINE);
+    const size_t slope_off = off;
+    off = not_stisla_align_up(off + segments * sizeof(double), NOT_STISLA_CACHE_LINE);
+    const size_t err_lo_off = off;
+    off += segments * sizeof(uint32_t);
+    const size_t err_hi_off = off;
+    off = not_stisla_align_up(off + segments * sizeof(uint32_t), NOT_STISLA_CACHE_LINE);
+    const size_t mode_off = any_mode ? off : 0;
+    if (any_mode) off = not_stisla_align_up(off + segments, NOT_STISLA_CACHE_LINE);
+    const size_t param_off = any_param ? off : 0;
+    if (any_param) off = not_stisla_align_up(off + segments * sizeof(int64_t), NOT_STISLA_CACHE_LINE);
+    const size_t tv_off = any_tv ? off : 0;
+    if (any_tv) off = not_stisla_align_up(off + count * sizeof(double), NOT_STISLA_CACHE_LINE);
+
+    not_stisla_frozen_t* f = aligned_alloc(NOT_STISLA_CACHE_LINE, off);
+    if (!f) {
+        free(modes);
+        return NULL;
+    }
+    memset(f, 0, off);
+
+    f->magic = NOT_STISLA_FROZEN_MAGIC;
+    f->bytes = off;
+    f->n = n;
+    f->anchors = count;
+    f->keys_off = keys_off;
+    f->idx_off = idx_off;
+    f->slope_off = slope_off;
+    f->err_lo_off = err_lo_off;
+    f->err_hi_off = err_hi_off;
+    f->mode_off = mode_off;
+    f->param_off = param_off;
+    f->tv_off = tv_off;
+    f->key_base = src[0].v;
+    f->key_bytes = (uint32_t)key_bytes;
+    f->idx_bytes = (uint32_t)idx_bytes;
+    if (any_tv) f->transform = *xf;
+
+    double* slope = NOT_STISLA_FROZEN_ARRAY(f, double, slope_off);
+    uint32_t* err_lo = NOT_STISLA_FROZEN_ARRAY(f, uint32_t, err_lo_off);
+    uint32_t* err_hi = NOT_STISLA_FROZEN_ARRAY(f, uint32_t, err_hi_off);
+
+    for (size_t k = 0; k < count; ++k) {
+        if (key_bytes == 4) {
+            NOT_STISLA_FROZEN_ARRAY(f, uint32_t, keys_off)[k] = (uint32_t)((uint64_t)src[k].v - (uint64_t)src[0].v);
+        } else {
+            NOT_STISLA_FROZEN_ARRAY(f, int64_t, keys_off)[k] = src[k].v;
+        }
+        if (idx_bytes == 4) {
+            NOT_STISLA_FROZEN_ARRAY(f, uint32_t, idx_off)[k] = (uint32_t)src[k].i;
+        } else {
+            NOT_STISLA_FROZEN_ARRAY(f, uint64_t, idx_off)[k] = src[k].i;
+        }
+        if (any_tv) NOT_STISLA_FROZEN_ARRAY(f, double, tv_off)[k] = not_stisla_transform_apply(xf, src[k].v);
+    }
+
+    /* Slopes and exact per-segment error bounds over every key */
+    size_t max_window = 1;
+    for (size_t s = 0; s < segments; ++s) {
+        const size_t left = src[s].i;
+        const size_t right = src[s + 1].i;
+        const uint64_t range = (uint64_t)src[s + 1].v - (uint64_t)src[s].v;
+        slope[s] = range ? (double)(right - left) / (double)range : 0.0;
+        if (any_mode) NOT_STISLA_FROZEN_ARRAY(f, uint8_t, mode_off)[s] = modes[s];
+        if (modes[s] == NOT_STISLA_FROZEN_CURVED) NOT_STISLA_FROZEN_ARRAY(f, int64_t, param_off)[s] = src[s].mv;
+        if (modes[s] == NOT_STISLA_FROZEN_EXACT) {
+            NOT_STISLA_FROZEN_ARRAY(f, int64_t, param_off)[s] = (int64_t)(range / (right - left));
+        }
+
+        /* Bounds measured with the segment's own predictor hold for any key */
+        size_t lo_err = 0;
+        size_t hi_err = 0;
+        for (size_t i = left; i <= right; ++i) {
+            const size_t pred = not_stisla_frozen_segment_predict(f, s, left, right, arr[i]);
+            if (pred > i && pred - i > lo_err) lo_err = pred - i;
+            if (i > pred && i - pred > hi_err) hi_err = i - pred;
+        }
+        err_lo[s] = lo_err > UINT32_MAX ? UINT32_MAX : (uint32_t)lo_err;
+        err_hi[s] = hi_err > UINT32_MAX ? UINT32_MAX : (uint32_t)hi_err;
+
+        /* Windows never leave the segment, so its length also caps them */
+        size_t window = lo_err + hi_err + 1;
+        if (window > right - left + 1) window = right - left + 1;
+        if (window > max_window) max_window = window;
+    }
+
+    while (((size_t)1 << f->window_steps) < max_window) f->window_steps++;
+
+    free(modes);
+    return f;
+}
+
+void not_stisla_frozen_destroy(not_stisla_frozen_t* frozen) {
+    free(frozen);
+}
+
+size_t not_stisla_frozen_size_bytes(const not_stisla_frozen_t* frozen) {
+    return frozen ? (size_t)frozen->bytes : 0;
+}
+
+/* Whether count elements of width bytes at off lie inside the block, past
+ * the header and aligned; overflow-safe for any stored values */
+static bool not_stisla_frozen_range_ok(const not_stisla_frozen_t* f, uint64_t off, uint64_t count, uint64_t width) {
+    if (off < sizeof(not_stisla_frozen_t) || off > f->bytes || off % width != 0) return false;
+    return count <= (f->bytes - off) / width;
+}
+
+const not_stisla_frozen_t* not_stisla_frozen_attach(const void* data, size_t len) {
+    const not_stisla_frozen_t* f = data;
+    if (!f || ((uintptr_t)data % 8) != 0 || len < sizeof(not_stisla_frozen_t)) return NULL;
+    if (f->magic != NOT_STISLA_FROZEN_MAGIC || f->bytes > len || f->bytes < sizeof(not_stisla_frozen_t)) return NULL;
+    if (f->anchors < 2 || f->n < f->anchors || f->window_steps >= 64) return NULL;
+    if ((f->key_bytes != 4 && f->key_bytes != 8) || (f->idx_bytes != 4 && f->idx_bytes != 8)) return NULL;
+
+    /* Every array inside the block */
+    const uint64_t segments = f->anchors - 1;
+    if (!not_stisla_frozen_range_ok(f, f->keys_off, f->anchors, f->key_bytes) ||
+        !not_stisla_frozen_range_ok(f, f->idx_off, f->anchors, f->idx_bytes) ||
+        !not_stisla_frozen_range_ok(f, f->slope_off, segments, sizeof(double)) ||
+        !not_stisla_frozen_range_ok(f, f->err_lo_off, segments, sizeof(uint32_t)) ||
+        !not_stisla_frozen_range_ok(f, f->err_hi_off, segments, sizeof(uint32_t))) {
+        return NULL;
+    }
+    if (f->mode_off && !not_stisla_frozen_range_ok(f, f->mode_off, segments, sizeof(uint8_t))) return NULL;
+    if (f->param_off && !not_stisla_frozen_range_ok(f, f->param_off, segments, sizeof(int64_t))) return NULL;
+    if (f->tv_off && !not_stisla_frozen_range_ok(f, f->tv_off, f->anchors, sizeof(double))) return NULL;
+    if (f->tv_off && f->transform.kind == NOT_STISLA_TRANSFORM_PIECEWISE &&
+        (f->transform.knots < 2 || f->transform.knots > NOT_STISLA_TRANSFORM_KNOTS)) {
+        return NULL;
+    }
+
+    /* Anchors span [0, n - 1] in order, so every window stays inside the array */
+    if (not_stisla_frozen_idx(f, 0) != 0 || not_stisla_frozen_idx(f, segments) != f->n - 1) return NULL;
+    if (f->key_bytes == 4 && NOT_STISLA_FROZEN_CARRAY(f, uint32_t, keys_off)[0] != 0) return NULL;
+
+    const double* slope = NOT_STISLA_FROZEN_CARRAY(f, double, slope_off);
+    const uint32_t* err_lo = NOT_STISLA_FROZEN_CARRAY(f, uint32_t, err_lo_off);
+    const uint32_t* err_hi = NOT_STISLA_FROZEN_CARRAY(f, uint32_t, err_hi_off);
+    for (uint64_t s = 0; s < segments; ++s) {
+        const size_t left = not_stisla_frozen_idx(f, s);
+        const size_t right = not_stisla_frozen_idx(f, s + 1);
+        if (right <= left || not_stisla_frozen_key(f, s + 1) < not_stisla_frozen_key(f, s)) return NULL;
+        const uint64_t range = (uint64_t)not_stisla_frozen_key(f, s + 1) - (uint64_t)not_stisla_frozen_key(f, s);
+
+        /* Predictions stay within [left, right] */
+        if (!(slope[s] >= 0.0) || slope[s] * (double)range > (double)(right - left) + 1.0) return NULL;
+        const unsigned mode = f->mode_off ? NOT_STISLA_FROZEN_CARRAY(f, uint8_t, mode_off)[s]
+                                          : NOT_STISLA_FROZEN_LINEAR;
+        switch (mode) {
+            case NOT_STISLA_FROZEN_LINEAR:
+                break;
+            case NOT_STISLA_FROZEN_CURVED:
+                if (!f->param_off) return NULL;
+                break;
+            case NOT_STISLA_FROZEN_TRANSFORMED:
+                if (!f->tv_off) return NULL;
+                break;
+            case NOT_STISLA_FROZEN_EXACT: {
+                if (!f->param_off) return NULL;
+                const uint64_t stride = (uint64_t)NOT_STISLA_FROZEN_CARRAY(f, int64_t, param_off)[s];
+                if (stride == 0 || range / stride != right - left || range % stride != 0) return NULL;
+                break;
+            }
+            default:
+                return NULL;
+        }
+
+        /* The bounded search's fixed step count must close every window */
+        uint64_t window = (uint64_t)err_lo[s] + err_hi[s] + 1;
+        if (window > right - left + 1) window = right - left + 1;
+        if (window > (1ULL << f->window_steps)) return NULL;
+    }
+    return f;
+}
+
+not_stisla_result_t not_stisla_frozen_search(const not_stisla_frozen_t* frozen, const int64_t* arr, int64_t key) {
+    if (!frozen || !arr) return NOT_STISLA_NOT_FOUND;
+
+    size_t lo, hi;
+    if (!not_stisla_frozen_window(frozen, key, &lo, &hi)) return NOT_STISLA_NOT_FOUND;
+
+    /* Step 4: Lower bound inside the window; the bound guarantees the hit */
+    while (lo < hi) {
+        const size_t mid = lo + ((hi - lo) >> 1);
+        if (arr[mid] < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return arr[lo] == key ? lo : NOT_STISLA_NOT_FOUND;
+}
+
+size_t not_stisla_frozen_max_probes(const not_stisla_frozen_t* frozen) {
+    if (!frozen) return 0;
+
+    /* Anchor reads: every key below the scan limit, else one per halving */
+    size_t anchor_probes = 0;
+    if (frozen->anchors <= NOT_STISLA_ANCHOR_SCAN) {
+        anchor_probes = frozen->anchors;
+    } else {
+        while (((size_t)1 << anchor_probes) < frozen->anchors) anchor_probes++;
+    }
+
+    /* Array reads: one per halving, then the landing key and its neighbour */
+    return anchor_probes + (size_t)frozen->window_steps + 2;
+}
+
+not_stisla_result_t not_stisla_frozen_search_bounded(const not_stisla_frozen_t* frozen, const int64_t* arr,
+                                                     int64_t key) {
+    if (!frozen || !arr) return NOT_STISLA_NOT_FOUND;
+
+    size_t lo, hi;
+    if (!not_stisla_frozen_window(frozen, key, &lo, &hi)) return NOT_STISLA_NOT_FOUND;
+
+    /* Step 4: Branch-free lower bound run for the model's fixed step count.
+     * Once the window is closed a step rereads base[0] and changes nothing,
+     * so every lookup does the same work as the widest one. */
+    const int64_t* base = arr + lo;
+    size_t len = hi - lo + 1;
+    for (uint64_t step = 0; step < frozen->window_steps; ++step) {
+        const size_t half = len >> 1;
+        base = (base[half] < key) ? base + half : base;
+        len -= half;
+    }
+    const size_t pos = (size_t)(base - arr) + (*base < key);
+
+    return (pos <= hi && arr[pos] == key) ? pos : NOT_STISLA_NOT_FOUND;
+}
+
+/* Tracing hook; trace points only exist when built with NOT_STISLA_TRACE */
+#ifdef NOT_STISLA_TRACE
+static _Atomic(not_stisla_trace_fn) not_stisla_trace_hook;
+static _Atomic(void*) not_stisla_trace_ctx;
+/* Cycles spent inside the hook; initial-exec keeps the access a single
+ * %fs-relative load in the shared library too */
+static _Thread_local uint64_t not_stisla_trace_paused __attribute__((tls_model("initial-exec")));
+
+void not_stisla_trace_emit(not_stisla_trace_phase_t phase, int64_t key, size_t pred, size_t window, size_t result) {
+    const not_stisla_trace_fn hook = atomic_load_explicit(&not_stisla_trace_hook, memory_order_acquire);
+    if (!hook) return;
+
+    /* The hook's own cost is taken off the clock so phases measure the search only */
+    const uint64_t now = not_stisla_cycles();
+    const not_stisla_trace_event_t event = {
+        .cycles = now - not_stisla_trace_paused,
+        .key = key,
+        .pred = pred,
+        .window = window,
+        .result = result,
+        .phase = (uint32_t)phase,
+    };
+    hook(atomic_load_explicit(&not_stisla_trace_ctx, memory_order_relaxed), &event);
+    not_stisla_trace_paused += not_stisla_cycles() - now;
+}
+#endif
+
+bool not_stisla_trace_set_hook(not_stisla_trace_fn hook, void* ctx) {
+#ifdef NOT_STISLA_TRACE
+    atomic_store_explicit(&not_stisla_trace_ctx, ctx, memory_order_relaxed);
+    atomic_store_explicit(&not_stisla_trace_hook, hook, memory_order_release);
+    return true;
+#else
+    (void)hook;
+    (void)ctx;
+    return false;
+#endif
+}
+
+void not_stisla_trace_write(void* file, const not_stisla_trace_event_t* event) {
+    if (file && event) fwrite(event, sizeof(*event), 1, (FILE*)file);
+}
+
 const char* not_stisla_version(void) {
     return NOT_STISLA_VERSION_STRING;
 }
@@ -0,0 +1,209 @@
+/**
+ * NOT_STISLA Append - Single-writer, many-reader appendable sorted array
+ *
+ * One thread appends keys while any number of threads search, without locks
+ *
+ * Features:
+ * - Streaming spline corridor: the model grows with the data
+ * - Length, knot count and tail knot published under a sequence lock
+ * - Readers never block; they retry only if they raced with a publish
+ * - Storage never moves, so published keys and knots stay valid
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "not_stisla_internal.h"
+#include <stdlib.h>
+#include <stdatomic.h>
+
+/* Configuration */
+#define NOT_STISLA_APPEND_KNOT_BLOCK_SHIFT 12  /* 4096 knots per block */
+#define NOT_STISLA_APPEND_KNOT_BLOCK (1u << NOT_STISLA_APPEND_KNOT_BLOCK_SHIFT)
+
+struct not_stisla_append {
+    int64_t* keys;                        /* capacity keys; [0, length) published */
+    size_t capacity;
+    size_t max_error;
+    not_stisla_spline_point_t** blocks;   /* Knot blocks, allocated as knots arrive */
+    size_t num_blocks;
+
+    /* Published model, written only inside the sequence lock */
+    _Alignas(64) atomic_size_t seq;       /* Odd while the writer publishes */
+    atomic_size_t length;
+    atomic_size_t knots;
+    _Atomic int64_t tail_x;               /* Last distinct key and its first position */
+    atomic_size_t tail_y;
+
+    /* Writer-private state */
+    _Alignas(64) not_stisla_spline_corridor_t corridor;
+    size_t size;
+    size_t num_knots;
+    atomic_size_t retries;                /* Reader retries, for monitoring */
+};
+
+static inline const not_stisla_spline_point_t* not_stisla_append_knot(const not_stisla_append_t* app, size_t k) {
+    return &app->blocks[k >> NOT_STISLA_APPEND_KNOT_BLOCK_SHIFT][k & (NOT_STISLA_APPEND_KNOT_BLOCK - 1)];
+}
+
+/* Writer: store a knot in its block; invisible to readers until published */
+static bool not_stisla_append_add_knot(not_stisla_append_t* app, int64_t x, uint64_t y) {
+    const size_t b = app->num_knots >> NOT_STISLA_APPEND_KNOT_BLOCK_SHIFT;
+    if (b >= app->num_blocks) return false;
+    if (!app->blocks[b]) {
+        app->blocks[b] = malloc(NOT_STISLA_APPEND_KNOT_BLOCK * sizeof(not_stisla_spline_point_t));
+        if (!app->blocks[b]) return false;
+    }
+    not_stisla_spline_point_t* knot = &app->blocks[b][app->num_knots & (NOT_STISLA_APPEND_KNOT_BLOCK - 1)];
+    knot->x = x;
+    knot->y = y;
+    app->num_knots++;
+    return true;
+}
+
+not_stisla_append_t* not_stisla_append_create(size_t capacity, size_t max_error) {
+    if (capacity == 0) return NULL;
+
+    not_stisla_append_t* app = calloc(1, sizeof(not_stisla_append_t));
+    if (!app) return NULL;
+
+    /* Every key can become a knot, so blocks are reserved for the worst case */
+    app->num_blocks = (capacity >> NOT_STISLA_APPEND_KNOT_BLOCK_SHIFT) + 1;
+    app->keys = malloc(capacity * sizeof(int64_t));
+    app->blocks = calloc(app->num_blocks, sizeof(not_stisla_spline_point_t*));
+    if (!app->keys || !app->blocks) {
+        not_stisla_append_destroy(app);
+        return NULL;
+    }
+
+    app->capacity = capacity;
+    app->max_error = max_error ? max_error : NOT_STISLA_SPLINE_DEFAULT_ERROR;
+    atomic_init(&app->seq, 0);
+    atomic_init(&app->length, 0);
+    atomic_init(&app->knots, 0);
+    atomic_init(&app->tail_x, 0);
+    atomic_init(&app->tail_y, 0);
+    atomic_init(&app->retries, 0);
+    return app;
+}
+
+void not_stisla_append_destroy(not_stisla_append_t* app) {
+    if (app) {
+        for (size_t b = 0; app->blocks && b < app->num_blocks; ++b) {
+            free(app->blocks[b]);
+        }
+        free(app->blocks);
+        free(app->keys);
+        free(app);
+    }
+}
+
+size_t not_stisla_append(not_stisla_append_t* app, const int64_t* keys, size_t count) {
+    if (!app || !keys) return 0;
+
+    /* Keys and knots land beyond what readers can see */
+    size_t added = 0;
+    while (added < count && app->size < app->capacity) {
+        const int64_t x = keys[added];
+        const size_t y = app->size;
+
+        if (y == 0) {
+            if (!not_stisla_append_add_knot(app, x, 0)) break;
+            not_stisla_spline_corridor_init(&app->corridor, x, 0, app->max_error);
+        } else if (x < app->corridor.prev_x) {
+            break;  /* Out of order: the array must stay sorted */
+        } else if (x != app->corridor.prev_x) {
+            not_stisla_spline_corridor_t next = app->corridor;
+            if (not_stisla_spline_corridor_step(&next, x, y) &&
+                !not_stisla_append_add_knot(app, next.knot_x, next.knot_y)) {
+                break;
+            }
+            app->corridor = next;
+        }
+
+        app->keys[y] = x;
+        app->size++;
+        added++;
+    }
+    if (added == 0) return 0;
+
+    /* Publish length and tail model together */
+    const size_t s = atomic_load_explicit(&app->seq, memory_order_relaxed);
+    atomic_store_explicit(&app->seq, s + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&app->length, app->size, memory_order_relaxed);
+    atomic_store_explicit(&app->knots, app->num_knots, memory_order_relaxed);
+    atomic_store_explicit(&app->tail_x, app->corridor.prev_x, memory_order_relaxed);
+    atomic_store_explicit(&app->tail_y, (size_t)app->corridor.prev_y, memory_order_relaxed);
+    atomic_store_explicit(&app->seq, s + 2, memory_order_release);
+
+    return added;
+}
+
+not_stisla_result_t not_stisla_append_search(not_stisla_append_t* app, int64_t key) {
+    if (!app) return NOT_STISLA_NOT_FOUND;
+
+    /* Step 1: Consistent snapshot of the published model */
+    size_t length, knots, tail_y;
+    int64_t tail_x;
+    for (;;) {
+        const size_t s1 = atomic_load_explicit(&app->seq, memory_order_acquire);
+        length = atomic_load_explicit(&app->length, memory_order_relaxed);
+        knots = atomic_load_explicit(&app->knots, memory_order_relaxed);
+        tail_x = atomic_load_explicit(&app->tail_x, memory_order_relaxed);
+        tail_y = atomic_load_explicit(&app->tail_y, memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+        if (!(s1 & 1) && atomic_load_explicit(&app->seq, memory_order_relaxed) == s1) break;
+        atomic_fetch_add_explicit(&app->retries, 1, memory_order_relaxed);
+    }
+
+    const int64_t* arr = app->keys;
+    if (length == 0 || key < arr[0] || key > tail_x) return NOT_STISLA_NOT_FOUND;
+
+    /* Step 2: First knot >= key; past the last knot the tail segment ends at the tail key */
+    size_t lo = 0;
+    size_t hi = knots;
+    while (lo < hi) {
+        const size_t mid = lo + ((hi - lo) >> 1);
+        if (not_stisla_append_knot(app, mid)->x < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    size_t pred;
+    if (lo < knots && not_stisla_append_knot(app, lo)->x == key) {
+        pred = (size_t)not_stisla_append_knot(app, lo)->y;
+    } else {
+        const not_stisla_spline_point_t* down = not_stisla_append_knot(app, lo - 1);
+        const int64_t up_x = (lo < knots) ? not_stisla_append_knot(app, lo)->x : tail_x;
+        const size_t up_y = (lo < knots) ? (size_t)not_stisla_append_knot(app, lo)->y : tail_y;
+        const double slope = (double)(up_y - down->y) / (double)((uint64_t)up_x - (uint64_t)down->x);
+        pred = (size_t)down->y + (size_t)((double)((uint64_t)key - (uint64_t)down->x) * slope + 0.5);
+    }
+
+    /* Step 3: Every published key's first occurrence is within max_error */
+    lo = pred > app->max_error ? pred - app->max_error : 0;
+    hi = pred + app->max_error + 1 < length ? pred + app->max_error + 1 : length;
+    while (lo < hi) {
+        const size_t mid = lo + ((hi - lo) >> 1);
+        if (arr[mid] < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return (lo < length && arr[lo] == key) ? lo : NOT_STISLA_NOT_FOUND;
+}
+
+size_t not_stisla_append_length(const not_stisla_append_t* app) {
+    return app ? atomic_load_explicit(&app->length, memory_order_acquire) : 0;
+}
+
+const int64_t* not_stisla_append_data(const not_stisla_append_t* app) {
+    return app ? app->keys : NULL;
+}
+
+size_t not_stisla_append_retries(const not_stisla_append_t* app) {
+    return app ? atomic_load_explicit(&app->retries, memory_order_relaxed) : 0;
+}
@@ -0,0 +1,236 @@
+/**
+ * NOT_STISLA Delta-of-Delta - Timestamp column searched one block at a time
+ *
+ * Stores sorted timestamps as Gorilla-style delta-of-delta codes in blocks
+ * that each restart from an unpacked first timestamp
+ *
+ * Features:
+ * - Regular sampling costs one bit per timestamp; jitter a few more
+ * - Gorilla's prefix classes (0, 7, 9, 12, 32 bits) plus a 64-bit class,
+ *   so any int64_t column round-trips exactly
+ * - Lookups interpolate over the block heads, then decode one block from
+ *   its head and stop at the first timestamp >= the key: at most
+ *   block_keys - 1 codes per lookup
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "not_stisla_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Configuration */
+#define NOT_STISLA_DOD_DEFAULT_BLOCK 128
+#define NOT_STISLA_DOD_CLASSES 6
+#define NOT_STISLA_DOD_PREFIX_MAX 5  /* Class k < 5 is k ones and a zero; class 5 is five ones */
+
+/* Zigzagged bits per class */
+static const uint8_t not_stisla_dod_width[NOT_STISLA_DOD_CLASSES] = { 0, 7, 9, 12, 32, 64 };
+static const uint64_t not_stisla_dod_mask[NOT_STISLA_DOD_CLASSES] = {
+    0, 0x7f, 0x1ff, 0xfff, 0xffffffffULL, ~0ULL
+};
+
+struct not_stisla_dod {
+    size_t n;
+    size_t block_keys;
+    size_t num_blocks;
+    int64_t last;        /* Largest timestamp */
+    int64_t* heads;      /* First timestamp of each block */
+    uint64_t* offsets;   /* Bit where each block's codes start */
+    uint64_t* bits;      /* Codes, plus one padding word */
+    size_t bit_words;
+};
+
+/* Sequential decoder over one block */
+typedef struct {
+    const uint64_t* bits;
+    uint64_t at;
+    uint64_t value;
+    uint64_t delta;
+} not_stisla_dod_cursor_t;
+
+static inline uint64_t not_stisla_dod_zigzag(uint64_t dod) {
+    return (dod << 1) ^ (uint64_t)((int64_t)dod >> 63);
+}
+
+static inline uint64_t not_stisla_dod_unzigzag(uint64_t zz) {
+    return (zz >> 1) ^ (0 - (zz & 1));
+}
+
+/* Smallest class holding zz */
+static inline unsigned not_stisla_dod_class(uint64_t zz) {
+    unsigned k = 0;
+    while (k + 1 < NOT_STISLA_DOD_CLASSES && zz >> not_stisla_dod_width[k]) ++k;
+    return k;
+}
+
+static inline unsigned not_stisla_dod_prefix_len(unsigned k) {
+    return k < NOT_STISLA_DOD_PREFIX_MAX ? k + 1 : NOT_STISLA_DOD_PREFIX_MAX;
+}
+
+/* Bits the code for dod takes */
+static inline unsigned not_stisla_dod_code_bits(uint64_t dod) {
+    const unsigned k = not_stisla_dod_class(not_stisla_dod_zigzag(dod));
+    return not_stisla_dod_prefix_len(k) + not_stisla_dod_width[k];
+}
+
+static uint64_t not_stisla_dod_put(uint64_t* bits, uint64_t at, uint64_t dod) {
+    const uint64_t zz = not_stisla_dod_zigzag(dod);
+    const unsigned k = not_stisla_dod_class(zz);
+    const unsigned plen = not_stisla_dod_prefix_len(k);
+    not_stisla_bits_write(bits, at, plen, (1ULL << k) - 1);  /* k ones, then a zero if k < 5 */
+    not_stisla_bits_write(bits, at + plen, not_stisla_dod_width[k], zz);
+    return at + plen + not_stisla_dod_width[k];
+}
+
+/* 64 bits from bit at, without a branch on the offset */
+static inline uint64_t not_stisla_dod_window(const uint64_t* bits, uint64_t at) {
+    const unsigned off = (unsigned)(at & 63);
+    return (bits[at >> 6] >> off) | ((bits[(at >> 6) + 1] << 1) << (63 - off));
+}
+
+/* One 64-bit window holds the prefix and value of every class but the
+ * 64-bit one, which reads its value again */
+static inline void not_stisla_dod_step(not_stisla_dod_cursor_t* c) {
+    const uint64_t window = not_stisla_dod_window(c->bits, c->at);
+    const unsigned k = (unsigned)__builtin_ctzll(~window | (1ULL << NOT_STISLA_DOD_PREFIX_MAX));
+    const unsigned plen = not_stisla_dod_prefix_len(k);
+    const uint64_t zz = (k + 1 < NOT_STISLA_DOD_CLASSES) ? (window >> plen) & not_stisla_dod_mask[k]
+                                                          : not_stisla_dod_window(c->bits, c->at + plen);
+    c->at += plen + not_stisla_dod_width[k];
+    c->delta += not_stisla_dod_unzigzag(zz);
+    c->value += c->delta;
+}
+
+static inline void not_stisla_dod_open(const not_stisla_dod_t* d, size_t b, not_stisla_dod_cursor_t* c) {
+    c->bits = d->bits;
+    c->at = d->offsets[b];
+    c->value = (uint64_t)d->heads[b];
+    c->delta = 0;
+}
+
+static inline size_t not_stisla_dod_block_len(const not_stisla_dod_t* d, size_t b) {
+    return (b + 1 < d->num_blocks) ? d->block_keys : d->n - b * d->block_keys;
+}
+
+not_stisla_dod_t* not_stisla_dod_build(const int64_t* ts, size_t n, size_t block_keys) {
+    if (!ts || n == 0) return NULL;
+    if (block_keys == 0) block_keys = NOT_STISLA_DOD_DEFAULT_BLOCK;
+
+    not_stisla_dod_t* d = calloc(1, sizeof(not_stisla_dod_t));
+    if (!d) return NULL;
+    d->n = n;
+    d->block_keys = block_keys;
+    d->num_blocks = (n + block_keys - 1) / block_keys;
+    d->last = ts[n - 1];
+    d->heads = malloc(d->num_blocks * sizeof(int64_t));
+    d->offsets = malloc(d->num_blocks * sizeof(uint64_t));
+    if (!d->heads || !d->offsets) {
+        not_stisla_dod_destroy(d);
+        return NULL;
+    }
+
+    /* First pass sizes every block; each restarts with a zero delta */
+    uint64_t total = 0;
+    for (size_t b = 0; b < d->num_blocks; ++b) {
+        const int64_t* block = ts + b * block_keys;
+        const size_t cnt = not_stisla_dod_block_len(d, b);
+        d->heads[b] = block[0];
+        d->offsets[b] = total;
+        uint64_t prev = 0;
+        for (size_t j = 1; j < cnt; ++j) {
+            const uint64_t delta = (uint64_t)block[j] - (uint64_t)block[j - 1];
+            total += not_stisla_dod_code_bits(delta - prev);
+            prev = delta;
+        }
+    }
+
+    d->bit_words = (size_t)((total + 63) / 64) + 1;
+    d->bits = calloc(d->bit_words, sizeof(uint64_t));
+    if (!d->bits) {
+        not_stisla_dod_destroy(d);
+        return NULL;
+    }
+
+    for (size_t b = 0; b < d->num_blocks; ++b) {
+        const int64_t* block = ts + b * block_keys;
+        const size_t cnt = not_stisla_dod_block_len(d, b);
+        uint64_t at = d->offsets[b], prev = 0;
+        for (size_t j = 1; j < cnt; ++j) {
+            const uint64_t delta = (uint64_t)block[j] - (uint64_t)block[j - 1];
+            at = not_stisla_dod_put(d->bits, at, delta - prev);
+            prev = delta;
+        }
+    }
+    return d;
+}
+
+void not_stisla_dod_destroy(not_stisla_dod_t* dod) {
+    if (dod) {
+        free(dod->heads);
+        free(dod->offsets);
+        free(dod->bits);
+        free(dod);
+    }
+}
+
+size_t not_stisla_dod_length(const not_stisla_dod_t* dod) {
+    return dod ? dod->n : 0;
+}
+
+size_t not_stisla_dod_size_bytes(const not_stisla_dod_t* dod) {
+    if (!dod) return 0;
+    return sizeof(not_stisla_dod_t) + dod->num_blocks * (sizeof(int64_t) + sizeof(uint64_t)) +
+           dod->bit_words * sizeof(uint64_t);
+}
+
+int64_t not_stisla_dod_get(const not_stisla_dod_t* dod, size_t i) {
+    if (!dod || i >= dod->n) return 0;
+    not_stisla_dod_cursor_t c;
+    not_stisla_dod_open(dod, i / dod->block_keys, &c);
+    for (size_t j = i % dod->block_keys; j > 0; --j) not_stisla_dod_step(&c);
+    return (int64_t)c.value;
+}
+
+size_t not_stisla_dod_decode_block(const not_stisla_dod_t* dod, size_t block, int64_t* out) {
+    if (!dod || !out || block >= dod->num_blocks) return 0;
+    const size_t cnt = not_stisla_dod_block_len(dod, block);
+    not_stisla_dod_cursor_t c;
+    not_stisla_dod_open(dod, block, &c);
+    out[0] = (int64_t)c.value;
+    for (size_t j = 1; j < cnt; ++j) {
+        not_stisla_dod_step(&c);
+        out[j] = (int64_t)c.value;
+    }
+    return cnt;
+}
+
+size_t not_stisla_dod_next_geq(const not_stisla_dod_t* dod, int64_t key, int64_t* value) {
+    if (!dod) return 0;
+    if (key <= dod->heads[0]) {
+        if (value) *value = dod->heads[0];
+        return 0;
+    }
+    if (key > dod->last) return dod->n;
+
+    /* The block's head is below key; the answer is in it or is the next head */
+    const size_t b = not_stisla_find_block(dod->heads, dod->n, dod->last, dod->block_keys, key);
+    const size_t cnt = not_stisla_dod_block_len(dod, b);
+    not_stisla_dod_cursor_t c;
+    not_stisla_dod_open(dod, b, &c);
+    for (size_t j = 1; j < cnt; ++j) {
+        not_stisla_dod_step(&c);
+        if ((int64_t)c.value >= key) {
+            if (value) *value = (int64_t)c.value;
+            return b * dod->block_keys + j;
+        }
+    }
+    if (value) *value = dod->heads[b + 1];
+    return (b + 1) * dod->block_keys;
+}
+
+not_stisla_result_t not_stisla_dod_search(const not_stisla_dod_t* dod, int64_t key) {
+    int64_t found;
+    const size_t i = not_stisla_dod_next_geq(dod, key, &found);
+    return (dod && i < dod->n && found == key) ? i : NOT_STISLA_NOT_FOUND;
+}
@@ -0,0 +1,214 @@
+/**
+ * NOT_STISLA Elias-Fano - Compressed sorted key set with model-guided select
+ *
+ * Stores n sorted keys in about 2 + log2(universe / n) bits each
+ *
+ * Features:
+ * - Low bits packed at a fixed width, high bits as unary bucket counts
+ * - One rank sample per 512-bit block of high bits, no select samples
+ * - Select predicts the block by interpolation, as the anchor search
+ *   predicts an index, then gallops over the rank samples to correct it
+ * - Popcount per word and pdep select inside a word where available
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "not_stisla_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Configuration */
+#define NOT_STISLA_EF_BLOCK_WORDS 8  /* 512 high bits per rank sample: one cache line */
+#define NOT_STISLA_EF_BLOCK_BITS (NOT_STISLA_EF_BLOCK_WORDS * 64)
+
+struct not_stisla_ef {
+    size_t n;
+    int64_t base;        /* Smallest key; stored values are key - base */
+    uint64_t max;        /* Largest stored value */
+    unsigned low_bits;   /* Width of each packed low part */
+    uint64_t* low;       /* n * low_bits bits, plus one padding word */
+    uint64_t* high;      /* Element i sets bit (value_i >> low_bits) + i */
+    size_t high_bits;    /* n + buckets */
+    size_t blocks;       /* high is blocks * 8 words */
+    uint64_t* rank;      /* rank[b] = ones before block b, blocks + 1 entries */
+};
+
+static inline unsigned not_stisla_ef_popcount(uint64_t w) {
+    return (unsigned)__builtin_popcountll(w);
+}
+
+/* Position of the k-th set bit of w (k < popcount(w)) */
+static inline unsigned not_stisla_ef_select_in_word(uint64_t w, unsigned k) {
+#ifdef __BMI2__
+    return (unsigned)__builtin_ctzll(_pdep_u64(1ULL << k, w));
+#else
+    for (unsigned j = 0; j < k; ++j) w &= w - 1;
+    return (unsigned)__builtin_ctzll(w);
+#endif
+}
+
+static inline uint64_t not_stisla_ef_low(const not_stisla_ef_t* ef, size_t i) {
+    return not_stisla_bits_read(ef->low, (uint64_t)i * ef->low_bits, ef->low_bits);
+}
+
+/* Ones (or zeros) in the high bits before block b */
+static inline size_t not_stisla_ef_count_before(const not_stisla_ef_t* ef, size_t b, bool zeros) {
+    return zeros ? b * NOT_STISLA_EF_BLOCK_BITS - ef->rank[b] : ef->rank[b];
+}
+
+/* Block holding the k-th one or zero: interpolate k over the total count to
+ * predict it, then gallop over the rank samples from there */
+static size_t not_stisla_ef_find_block(const not_stisla_ef_t* ef, size_t k, size_t total, bool zeros) {
+    size_t b = (size_t)not_stisla_interpolate(0, (int64_t)total, 0, ef->blocks, (int64_t)k);
+    if (b >= ef->blocks) b = ef->blocks - 1;
+
+    size_t lo, hi, step = 1;
+    if (not_stisla_ef_count_before(ef, b, zeros) > k) {
+        hi = b;
+        while (step <= hi && not_stisla_ef_count_before(ef, hi - step, zeros) > k) step <<= 1;
+        lo = (step <= hi) ? hi - step : 0;
+    } else {
+        lo = b;
+        while (lo + step < ef->blocks && not_stisla_ef_count_before(ef, lo + step, zeros) <= k) step <<= 1;
+        hi = (lo + step < ef->blocks) ? lo + step : ef->blocks;
+    }
+
+    /* Last block in [lo, hi) with at most k before it */
+    while (hi - lo > 1) {
+        const size_t mid = lo + ((hi - lo) >> 1);
+        if (not_stisla_ef_count_before(ef, mid, zeros) <= k) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/* Bit position of the k-th one (zeros false, k < n) or zero (zeros true) */
+static size_t not_stisla_ef_select(const not_stisla_ef_t* ef, size_t k, bool zeros) {
+    const size_t total = zeros ? ef->high_bits - ef->n : ef->n;
+    const size_t b = not_stisla_ef_find_block(ef, k, total, zeros);
+
+    size_t left = k - not_stisla_ef_count_before(ef, b, zeros);
+    const uint64_t* w = ef->high + b * NOT_STISLA_EF_BLOCK_WORDS;
+    for (size_t j = 0;; ++j) {
+        const uint64_t word = zeros ? ~w[j] : w[j];
+        const unsigned c = not_stisla_ef_popcount(word);
+        if (left < c) {
+            return (b * NOT_STISLA_EF_BLOCK_WORDS + j) * 64 + not_stisla_ef_select_in_word(word, (unsigned)left);
+        }
+        left -= c;
+    }
+}
+
+not_stisla_ef_t* not_stisla_ef_build(const int64_t* arr, size_t n) {
+    if (!arr || n == 0) return NULL;
+
+    not_stisla_ef_t* ef = calloc(1, sizeof(not_stisla_ef_t));
+    if (!ef) return NULL;
+    ef->n = n;
+    ef->base = arr[0];
+    ef->max = (uint64_t)arr[n - 1] - (uint64_t)arr[0];
+
+    /* low_bits = floor(log2(universe / n)) balances the two halves */
+    const uint64_t ratio = ef->max / n;
+    ef->low_bits = ratio ? 63u - (unsigned)__builtin_clzll(ratio) : 0;
+
+    const size_t buckets = (size_t)(ef->max >> ef->low_bits) + 1;
+    ef->high_bits = n + buckets;
+    ef->blocks = (ef->high_bits + NOT_STISLA_EF_BLOCK_BITS - 1) / NOT_STISLA_EF_BLOCK_BITS;
+    const size_t low_words = (n * ef->low_bits + 63) / 64 + 1;
+
+    ef->low = calloc(low_words, sizeof(uint64_t));
+    ef->high = aligned_alloc(64, ef->blocks * NOT_STISLA_EF_BLOCK_WORDS * sizeof(uint64_t));
+    ef->rank = malloc((ef->blocks + 1) * sizeof(uint64_t));
+    if (!ef->low || !ef->high || !ef->rank) {
+        not_stisla_ef_destroy(ef);
+        return NULL;
+    }
+    memset(ef->high, 0, ef->blocks * NOT_STISLA_EF_BLOCK_WORDS * sizeof(uint64_t));
+
+    const uint64_t low_mask = ef->low_bits ? (1ULL << ef->low_bits) - 1 : 0;
+    for (size_t i = 0; i < n; ++i) {
+        const uint64_t v = (uint64_t)arr[i] - (uint64_t)ef->base;
+        not_stisla_bits_write(ef->low, (uint64_t)i * ef->low_bits, ef->low_bits, v & low_mask);
+        const size_t pos = (size_t)(v >> ef->low_bits) + i;
+        ef->high[pos >> 6] |= 1ULL << (pos & 63);
+    }
+
+    uint64_t ones = 0;
+    for (size_t b = 0; b < ef->blocks; ++b) {
+        ef->rank[b] = ones;
+        for (size_t j = 0; j < NOT_STISLA_EF_BLOCK_WORDS; ++j) {
+            ones += not_stisla_ef_popcount(ef->high[b * NOT_STISLA_EF_BLOCK_WORDS + j]);
+        }
+    }
+    ef->rank[ef->blocks] = ones;
+    return ef;
+}
+
+void not_stisla_ef_destroy(not_stisla_ef_t* ef) {
+    if (ef) {
+        free(ef->low);
+        free(ef->high);
+        free(ef->rank);
+        free(ef);
+    }
+}
+
+size_t not_stisla_ef_length(const not_stisla_ef_t* ef) {
+    return ef ? ef->n : 0;
+}
+
+size_t not_stisla_ef_size_bytes(const not_stisla_ef_t* ef) {
+    if (!ef) return 0;
+    return sizeof(not_stisla_ef_t) + ((ef->n * ef->low_bits + 63) / 64 + 1) * sizeof(uint64_t) +
+           ef->blocks * NOT_STISLA_EF_BLOCK_WORDS * sizeof(uint64_t) + (ef->blocks + 1) * sizeof(uint64_t);
+}
+
+int64_t not_stisla_ef_get(const not_stisla_ef_t* ef, size_t i) {
+    if (!ef || i >= ef->n) return 0;
+    const uint64_t high = not_stisla_ef_select(ef, i, false) - i;
+    return (int64_t)((uint64_t)ef->base + ((high << ef->low_bits) | not_stisla_ef_low(ef, i)));
+}
+
+size_t not_stisla_ef_next_geq(const not_stisla_ef_t* ef, int64_t key, int64_t* value) {
+    if (!ef) return 0;
+    if (key <= ef->base) {
+        if (value) *value = ef->base;
+        return 0;
+    }
+    const uint64_t x = (uint64_t)key - (uint64_t)ef->base;
+    if (x > ef->max) return ef->n;
+
+    /* Bucket h starts after the h-th zero; everything before it is smaller */
+    const uint64_t h = x >> ef->low_bits;
+    size_t pos = h ? not_stisla_ef_select(ef, (size_t)h - 1, true) + 1 : 0;
+    size_t i = pos - (size_t)h;
+
+    /* Walk the bucket's ones; low bits are sorted inside a bucket */
+    const uint64_t low = x & (ef->low_bits ? (1ULL << ef->low_bits) - 1 : 0);
+    while ((ef->high[pos >> 6] >> (pos & 63)) & 1) {
+        if (not_stisla_ef_low(ef, i) >= low) break;
+        ++pos;
+        ++i;
+    }
+
+    /* Either a bucket-h key >= key, or the first key of a later bucket:
+     * the next one after pos, which exists since x <= max */
+    if (value) {
+        size_t w = pos >> 6;
+        uint64_t word = ef->high[w] & (~0ULL << (pos & 63));
+        while (!word) word = ef->high[++w];
+        const uint64_t high = (uint64_t)(w * 64 + (size_t)__builtin_ctzll(word)) - i;
+        *value = (int64_t)((uint64_t)ef->base + ((high << ef->low_bits) | not_stisla_ef_low(ef, i)));
+    }
+    return i;
+}
+
+not_stisla_result_t not_stisla_ef_search(const not_stisla_ef_t* ef, int64_t key) {
+    int64_t found;
+    const size_t i = not_stisla_ef_next_geq(ef, key, &found);
+    return (ef && i < ef->n && found == key) ? i : NOT_STISLA_NOT_FOUND;
+}
@@ -0,0 +1,155 @@
+/**
+ * NOT_STISLA Filter - Negative-lookup filter in front of a sorted array
+ *
+ * Rejects most absent keys with one cache line read, before any search
+ *
+ * Features:
+ * - Split-block Bloom filter: 256-bit blocks of eight 32-bit words
+ * - One bit per word, so a probe is one block load and one 8-lane test
+ * - AVX2 probe where available, identical scalar probe elsewhere
+ * - Memory set in bits per key; not_stisla_filter_bits_for_rate() picks it
+ *   from a target false positive rate
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "not_stisla_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* Configuration */
+#define NOT_STISLA_FILTER_DEFAULT_BITS 10   /* About 1.3% false positives */
+#define NOT_STISLA_FILTER_MAX_BITS 64
+#define NOT_STISLA_FILTER_WORDS 8           /* 32-bit words per block */
+#define NOT_STISLA_FILTER_BLOCK_BITS (NOT_STISLA_FILTER_WORDS * 32)
+
+struct not_stisla_filter {
+    uint32_t* blocks;    /* num_blocks * 8 words, cache-line aligned */
+    size_t num_blocks;
+    size_t keys;         /* Distinct keys inserted */
+};
+
+/* Odd multipliers, one per word, picking that word's bit from the hash */
+static const uint32_t not_stisla_filter_salt[NOT_STISLA_FILTER_WORDS] = {
+    0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+    0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U
+};
+
+/* 64-bit finalizer: sequential IDs must not land in neighbouring blocks */
+static inline uint64_t not_stisla_filter_hash(int64_t key) {
+    uint64_t h = (uint64_t)key;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/* High hash bits choose the block, low 32 bits the bit in each word */
+static inline const uint32_t* not_stisla_filter_block(const not_stisla_filter_t* f, uint64_t h) {
+    const size_t b = (size_t)(((unsigned __int128)h * f->num_blocks) >> 64);
+    return f->blocks + b * NOT_STISLA_FILTER_WORDS;
+}
+
+static void not_stisla_filter_insert(not_stisla_filter_t* f, int64_t key) {
+    const uint64_t h = not_stisla_filter_hash(key);
+    uint32_t* block = (uint32_t*)not_stisla_filter_block(f, h);
+    for (int w = 0; w < NOT_STISLA_FILTER_WORDS; ++w) {
+        block[w] |= 1u << (((uint32_t)h * not_stisla_filter_salt[w]) >> 27);
+    }
+}
+
+bool not_stisla_filter_may_contain(const not_stisla_filter_t* filter, int64_t key) {
+    if (!filter) return true;
+
+    const uint64_t h = not_stisla_filter_hash(key);
+    const uint32_t* block = not_stisla_filter_block(filter, h);
+#ifdef __AVX2__
+    const __m256i salt = _mm256_loadu_si256((const __m256i*)not_stisla_filter_salt);
+    const __m256i shift = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32((int)(uint32_t)h), salt), 27);
+    const __m256i mask = _mm256_sllv_epi32(_mm256_set1_epi32(1), shift);
+    return _mm256_testc_si256(_mm256_load_si256((const __m256i*)block), mask);
+#else
+    uint32_t hit = 1;
+    for (int w = 0; w < NOT_STISLA_FILTER_WORDS; ++w) {
+        hit &= block[w] >> (((uint32_t)h * not_stisla_filter_salt[w]) >> 27);
+    }
+    return hit & 1;
+#endif
+}
+
+/* Chance that an absent key finds all 8 bits set, averaged over block
+ * loads: Poisson(keys_per_block) keys per block, each setting one of 32
+ * bits per word */
+static double not_stisla_filter_expected_fp(double keys_per_block) {
+    const double miss = 1.0 - 1.0 / 32.0;
+    double p = exp(-keys_per_block);  /* P(j = 0) */
+    double fp = 0.0;
+    const size_t max_j = (size_t)(keys_per_block * 4.0) + 64;
+    for (size_t j = 1; j <= max_j; ++j) {
+        p *= keys_per_block / (double)j;
+        fp += p * pow(1.0 - pow(miss, (double)j), NOT_STISLA_FILTER_WORDS);
+    }
+    return fp;
+}
+
+size_t not_stisla_filter_bits_for_rate(double fp_rate) {
+    for (size_t bits = 1; bits < NOT_STISLA_FILTER_MAX_BITS; ++bits) {
+        if (not_stisla_filter_expected_fp((double)NOT_STISLA_FILTER_BLOCK_BITS / (double)bits) <= fp_rate) {
+            return bits;
+        }
+    }
+    return NOT_STISLA_FILTER_MAX_BITS;
+}
+
+not_stisla_filter_t* not_stisla_filter_build(const int64_t* arr, size_t n, size_t bits_per_key) {
+    if (!arr || n == 0) return NULL;
+    if (bits_per_key == 0) bits_per_key = NOT_STISLA_FILTER_DEFAULT_BITS;
+    if (bits_per_key > NOT_STISLA_FILTER_MAX_BITS) bits_per_key = NOT_STISLA_FILTER_MAX_BITS;
+
+    not_stisla_filter_t* f = calloc(1, sizeof(not_stisla_filter_t));
+    if (!f) return NULL;
+
+    f->num_blocks = (n * bits_per_key + NOT_STISLA_FILTER_BLOCK_BITS - 1) / NOT_STISLA_FILTER_BLOCK_BITS;
+    const size_t bytes = f->num_blocks * NOT_STISLA_FILTER_WORDS * sizeof(uint32_t);
+    f->blocks = aligned_alloc(64, (bytes + 63) & ~(size_t)63);
+    if (!f->blocks) {
+        free(f);
+        return NULL;
+    }
+    memset(f->blocks, 0, bytes);
+
+    /* Sorted input: a duplicate run inserts once */
+    for (size_t i = 0; i < n; ++i) {
+        if (i > 0 && arr[i] == arr[i - 1]) continue;
+        not_stisla_filter_insert(f, arr[i]);
+        f->keys++;
+    }
+    return f;
+}
+
+void not_stisla_filter_destroy(not_stisla_filter_t* filter) {
+    if (filter) {
+        free(filter->blocks);
+        free(filter);
+    }
+}
+
+size_t not_stisla_filter_size_bytes(const not_stisla_filter_t* filter) {
+    return filter ? filter->num_blocks * NOT_STISLA_FILTER_WORDS * sizeof(uint32_t) : 0;
+}
+
+double not_stisla_filter_fp_rate(const not_stisla_filter_t* filter) {
+    if (!filter) return 1.0;
+    return not_stisla_filter_expected_fp((double)filter->keys / (double)filter->num_blocks);
+}
+
+not_stisla_result_t not_stisla_search_ids_filtered(const int64_t* ids, size_t n, int64_t target_id,
+                                                   not_stisla_anchor_table_t* table,
+                                                   const not_stisla_filter_t* filter) {
+    /* Absent IDs stop here without touching the table or the array */
+    if (!not_stisla_filter_may_contain(filter, target_id)) return NOT_STISLA_NOT_FOUND;
+    return not_stisla_search_ids(ids, n, target_id, table);
+}
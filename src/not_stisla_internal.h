@@ -0,0 +1,329 @@
+/**
+ * NOT_STISLA Internal - Shared definitions between library translation units
+ *
+ * Not installed; the public API is include/not_stisla.h
+ */
+
+#ifndef NOT_STISLA_INTERNAL_H
+#define NOT_STISLA_INTERNAL_H
+
+#include "../include/not_stisla.h"
+#include <unistd.h>
+
+/* Cycle counter for tracing and timing: TSC on x86-64, nanoseconds elsewhere */
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+static inline uint64_t not_stisla_cycles(void) {
+    return __rdtsc();
+}
+#else
+#include <time.h>
+static inline uint64_t not_stisla_cycles(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+/* Static trace points at search phase boundaries. Built without
+ * NOT_STISLA_TRACE they expand to nothing; with NOT_STISLA_TRACE_USDT they
+ * also become USDT probes (provider not_stisla) for perf/bpftrace. */
+#ifdef NOT_STISLA_TRACE
+void not_stisla_trace_emit(not_stisla_trace_phase_t phase, int64_t key, size_t pred, size_t window, size_t result);
+#define NOT_STISLA_TRACE_HOOK(name, key, pred, window, result) \
+    not_stisla_trace_emit(NOT_STISLA_TRACE_##name, (key), (pred), (window), (result))
+#else
+#define NOT_STISLA_TRACE_HOOK(name, key, pred, window, result) ((void)0)
+#endif
+
+#ifdef NOT_STISLA_TRACE_USDT
+#include <sys/sdt.h>
+#define NOT_STISLA_TRACE_USDT_PROBE(name, key, pred, window, result) \
+    STAP_PROBE4(not_stisla, name, (key), (pred), (window), (result))
+#else
+#define NOT_STISLA_TRACE_USDT_PROBE(name, key, pred, window, result) ((void)0)
+#endif
+
+#define NOT_STISLA_TRACE_POINT(name, key, pred, window, result) \
+    do { \
+        NOT_STISLA_TRACE_HOOK(name, key, pred, window, result); \
+        NOT_STISLA_TRACE_USDT_PROBE(name, key, pred, window, result); \
+    } while (0)
+
+/* High-precision interpolation with overflow protection */
+static inline int64_t not_stisla_interpolate(int64_t l_val, int64_t r_val, size_t l_idx, size_t r_idx, int64_t key) {
+    const size_t span = r_idx - l_idx;
+
+    if (r_val == l_val) {
+        return (int64_t)l_idx;
+    }
+
+    /* Use 128-bit arithmetic to prevent overflow */
+    const __int128 key_offset = (__int128)key - (__int128)l_val;
+    const __int128 range = (__int128)r_val - (__int128)l_val;
+
+    if (range == 0) return (int64_t)l_idx;
+
+    const __int128 frac = (key_offset * (__int128)span) / range;
+    const __int128 result = (__int128)l_idx + frac;
+
+    /* Clamp result to valid range */
+    if (result < 0) return 0;
+    if ((size_t)result > r_idx) return (int64_t)r_idx;
+
+    return (int64_t)result;
+}
+
+/* Bit-packed fields, up to 64 bits wide. Arrays carry one padding word past
+ * the last field, so a field straddling two words never reads out of bounds. */
+static inline uint64_t not_stisla_bits_read(const uint64_t* bits, uint64_t at, unsigned width) {
+    if (width == 0) return 0;
+    const unsigned off = (unsigned)(at & 63);
+    uint64_t v = bits[at >> 6] >> off;
+    if (off + width > 64) v |= bits[(at >> 6) + 1] << (64 - off);
+    return width == 64 ? v : v & ((1ULL << width) - 1);
+}
+
+/* OR v, which must fit in width bits, into a zeroed field */
+static inline void not_stisla_bits_write(uint64_t* bits, uint64_t at, unsigned width, uint64_t v) {
+    if (width == 0) return;
+    const unsigned off = (unsigned)(at & 63);
+    bits[at >> 6] |= v << off;
+    if (off + width > 64) bits[(at >> 6) + 1] |= v >> (64 - off);
+}
+
+/* Last block of block_keys keys whose head is below key, for heads[0] < key
+ * <= last: interpolated over all n keys, then galloped over the heads */
+static inline size_t not_stisla_find_block(const int64_t* heads, size_t n, int64_t last, size_t block_keys,
+                                           int64_t key) {
+    const size_t nb = (n + block_keys - 1) / block_keys;
+    size_t b = (size_t)not_stisla_interpolate(heads[0], last, 0, n - 1, key) / block_keys;
+    if (b >= nb) b = nb - 1;
+
+    size_t lo, hi, step = 1;
+    if (heads[b] >= key) {
+        hi = b;
+        while (step <= hi && heads[hi - step] >= key) step <<= 1;
+        lo = (step <= hi) ? hi - step : 0;
+    } else {
+        lo = b;
+        while (lo + step < nb && heads[lo + step] < key) step <<= 1;
+        hi = (lo + step < nb) ? lo + step : nb;
+    }
+    while (hi - lo > 1) {
+        const size_t mid = lo + ((hi - lo) >> 1);
+        if (heads[mid] < key) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/* Optimized local binary search */
+static inline size_t not_stisla_local_search(const int64_t* arr, size_t lo, size_t hi, int64_t key) {
+    /* Quick bounds check */
+    if (lo > hi || arr[lo] > key || arr[hi] < key) {
+        return NOT_STISLA_NOT_FOUND;
+    }
+
+    /* Optimized binary search */
+    while (lo <= hi) {
+        size_t mid = lo + ((hi - lo) >> 1);  /* Fast divide by 2 */
+        int64_t val = arr[mid];
+
+        if (val < key) {
+            lo = mid + 1;
+        } else if (val > key) {
+            if (mid == 0) break;
+            hi = mid - 1;
+        } else {
+            return mid;
+        }
+    }
+
+    return NOT_STISLA_NOT_FOUND;
+}
+
+/* Anchor structure; error bounds describe the segment up to the next anchor */
+typedef struct {
+    int64_t v;        /* value */
+    size_t i;         /* index */
+    int64_t mv;       /* value at the segment midpoint, third knot for curved segments */
+    double tv;        /* value under the table's key transform */
+    uint32_t err_lo;  /* max keys left of the prediction (UINT32_MAX = whole segment) */
+    uint32_t err_hi;  /* max keys right of the prediction (UINT32_MAX = whole segment) */
+    uint32_t flags;   /* NOT_STISLA_SEG_* */
+} not_stisla_anchor_t;
+
+/* Segment flags */
+#define NOT_STISLA_SEG_BOUNDED 0x1u  /* err_lo/err_hi measured over every key */
+#define NOT_STISLA_SEG_CURVED 0x2u   /* Predict with three-point interpolation */
+#define NOT_STISLA_SEG_EXACT 0x4u    /* Keys form an arithmetic progression: index computed directly.
+                                        Proven when BOUNDED, otherwise a hint checked by one load */
+#define NOT_STISLA_SEG_UNPROBED 0x8u /* Auto mode: restarted without the keys, predictor not chosen yet */
+
+/* Index of key in an arithmetic-progression segment, computed directly.
+ * NOT_STISLA_NOT_FOUND if key falls between the progression's steps.
+ * Caller guarantees l->v <= key <= r->v. */
+static inline size_t not_stisla_exact_index(const not_stisla_anchor_t* l, const not_stisla_anchor_t* r, int64_t key) {
+    const uint64_t span = (uint64_t)r->v - (uint64_t)l->v;
+    const uint64_t count = r->i - l->i;
+    const uint64_t d = (uint64_t)key - (uint64_t)l->v;
+    if (span == count) return l->i + d;  /* Dense run of consecutive integers */
+    const uint64_t stride = span / count;
+    return (d % stride) ? NOT_STISLA_NOT_FOUND : l->i + d / stride;
+}
+
+/* Optimized anchor binary search with unrolling */
+static inline size_t not_stisla_anchor_lower(const not_stisla_anchor_t* anchors, size_t size, int64_t x) {
+    if (size == 0) return 0;
+
+    size_t lo = 0;
+    size_t hi = size - 1;
+
+    /* Manual unrolling for common small table sizes */
+    switch (hi - lo) {
+        case 0:
+            return anchors[lo].v <= x ? lo : 0;
+        case 1: {
+            const not_stisla_anchor_t* a0 = &anchors[lo];
+            const not_stisla_anchor_t* a1 = &anchors[hi];
+            if (a0->v <= x) {
+                return a1->v <= x ? hi : lo;
+            }
+            return 0;
+        }
+        case 2: {
+            const not_stisla_anchor_t* a0 = &anchors[lo];
+            const not_stisla_anchor_t* a1 = &anchors[lo + 1];
+            const not_stisla_anchor_t* a2 = &anchors[hi];
+            if (a1->v <= x) {
+                return a2->v <= x ? hi : lo + 1;
+            } else if (a0->v <= x) {
+                return lo;
+            }
+            return 0;
+        }
+        default:
+            /* Standard binary search for larger tables */
+            while (lo + 1 < hi) {
+                size_t mid = lo + ((hi - lo) >> 1);
+                if (anchors[mid].v <= x) {
+                    lo = mid;
+                } else {
+                    hi = mid;
+                }
+            }
+            return lo;
+    }
+}
+
+/* Spline configuration */
+#define NOT_STISLA_SPLINE_DEFAULT_ERROR 32
+#define NOT_STISLA_SPLINE_MIN_CHUNK (1u << 16)  /* Keys per build thread, at least */
+
+/* Spline knot: key and the position of its first occurrence */
+typedef struct {
+    int64_t x;
+    uint64_t y;
+} not_stisla_spline_point_t;
+
+/* Growable knot buffer used while fitting */
+typedef struct {
+    not_stisla_spline_point_t* points;
+    size_t size;
+    size_t capacity;
+} not_stisla_spline_buffer_t;
+
+/* Streaming state of the greedy spline corridor */
+typedef struct {
+    double e;
+    int64_t knot_x;   /* Last knot */
+    uint64_t knot_y;
+    int64_t prev_x;   /* Last distinct key fed, with its first position */
+    uint64_t prev_y;
+    double upper_x, upper_y, lower_x, lower_y;  /* Corridor edges, relative to the knot */
+} not_stisla_spline_corridor_t;
+
+/* Sign of the cross product of (dx1, dy1) and (dx2, dy2): > 0 counter-clockwise */
+static inline double not_stisla_spline_orient(double dx1, double dy1, double dx2, double dy2) {
+    return dx1 * dy2 - dy1 * dx2;
+}
+
+/* Start a corridor whose first knot is (x, y) */
+static inline void not_stisla_spline_corridor_init(not_stisla_spline_corridor_t* c, int64_t x, uint64_t y,
+                                                   size_t max_error) {
+    c->e = (double)max_error;
+    c->knot_x = c->prev_x = x;
+    c->knot_y = c->prev_y = y;
+    c->upper_x = c->upper_y = c->lower_x = c->lower_y = 0.0;
+}
+
+/* Feed the next distinct key at its first position. Returns true when the
+ * previous key had to become a knot; it is then in knot_x/knot_y. The line
+ * from the last knot to prev always predicts every key in between within e. */
+static inline bool not_stisla_spline_corridor_step(not_stisla_spline_corridor_t* c, int64_t x, uint64_t y) {
+    bool emitted = false;
+    double dx = (double)((uint64_t)x - (uint64_t)c->knot_x);
+    double dy = (double)y - (double)c->knot_y;
+
+    if (c->prev_y != c->knot_y &&
+        (not_stisla_spline_orient(c->upper_x, c->upper_y, dx, dy) > 0.0 ||
+         not_stisla_spline_orient(c->lower_x, c->lower_y, dx, dy) < 0.0)) {
+        /* Outside the corridor: the previous key becomes a knot */
+        c->knot_x = c->prev_x;
+        c->knot_y = c->prev_y;
+        dx = (double)((uint64_t)x - (uint64_t)c->knot_x);
+        dy = (double)y - (double)c->knot_y;
+        emitted = true;
+    }
+
+    if (c->prev_y == c->knot_y) {
+        /* Corridor opens at the first key after a knot */
+        c->upper_x = c->lower_x = dx;
+        c->upper_y = dy + c->e;
+        c->lower_y = dy - c->e;
+    } else {
+        /* Tighten the corridor */
+        if (not_stisla_spline_orient(c->upper_x, c->upper_y, dx, dy + c->e) < 0.0) {
+            c->upper_x = dx;
+            c->upper_y = dy + c->e;
+        }
+        if (not_stisla_spline_orient(c->lower_x, c->lower_y, dx, dy - c->e) > 0.0) {
+            c->lower_x = dx;
+            c->lower_y = dy - c->e;
+        }
+    }
+
+    c->prev_x = x;
+    c->prev_y = y;
+    return emitted;
+}
+
+/* Thread count for a parallel pass: 0 means online CPUs, and every thread
+ * gets at least min_chunk items */
+static inline size_t not_stisla_resolve_threads(size_t threads, size_t n, size_t min_chunk) {
+    if (threads == 0) {
+        const long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = online > 0 ? (size_t)online : 1;
+    }
+    if (threads > n / min_chunk) threads = n / min_chunk;
+    return threads ? threads : 1;
+}
+
+/* Fit spline knots over arr[begin, end), appending to buf */
+bool not_stisla_spline_fit(const int64_t* arr, size_t begin, size_t end, size_t max_error,
+                           not_stisla_spline_buffer_t* buf);
+
+/* Start of fitting chunk c of 'chunks'; chunk 'chunks' starts at n. Chunks
+ * begin at the first occurrence of a key so they can be fitted independently. */
+size_t not_stisla_spline_chunk_start(const int64_t* arr, size_t n, size_t chunks, size_t c);
+
+/* Concatenate per-chunk knots (in array order) into a spline with its radix
+ * table. Always releases the buffers' knots. */
+not_stisla_spline_t* not_stisla_spline_assemble(const int64_t* arr, size_t n, size_t max_error, unsigned radix_bits,
+                                                not_stisla_spline_buffer_t* bufs, size_t count);
+
+#endif /* NOT_STISLA_INTERNAL_H */
@@ -0,0 +1,200 @@
+/**
+ * NOT_STISLA Packed - Sorted keys stored as residuals against a linear model
+ *
+ * Keeps each block of keys as the line through its first and last key plus
+ * the bit-packed distance of every key from that line
+ *
+ * Features:
+ * - Per-block width: a block costs only as many bits as its worst residual
+ * - Block heads stay unpacked, so finding a block reads no residuals
+ * - Lookups interpolate to a block, then to a position inside it, and
+ *   decode single keys at random; no block is ever unpacked whole
+ * - Exact: decoding repeats the build's integer arithmetic bit for bit
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "not_stisla_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Configuration */
+#define NOT_STISLA_PACKED_DEFAULT_BLOCK 128
+#define NOT_STISLA_PACKED_MAX_SHIFT 32  /* Fraction bits of a block's slope */
+
+typedef struct {
+    uint64_t base;       /* First key plus the smallest residual */
+    uint64_t slope;      /* (last - first) / (keys - 1), shift fraction bits */
+    uint64_t offset;     /* First residual's bit in the packed array */
+    uint8_t width;       /* Bits per residual, 0 when the line is exact */
+    uint8_t shift;
+} not_stisla_packed_block_t;
+
+struct not_stisla_packed {
+    size_t n;
+    size_t block_keys;
+    size_t num_blocks;
+    int64_t last;                        /* Largest key */
+    int64_t* heads;                      /* First key of each block */
+    not_stisla_packed_block_t* blocks;
+    uint64_t* bits;                      /* Residuals, plus one padding word */
+    size_t bit_words;
+};
+
+/* Line value at position j of a block, as an offset from its first key */
+static inline uint64_t not_stisla_packed_line(const not_stisla_packed_block_t* blk, size_t j) {
+    return (uint64_t)(((unsigned __int128)blk->slope * j) >> blk->shift);
+}
+
+static inline int64_t not_stisla_packed_key(const not_stisla_packed_t* p, size_t b, size_t j) {
+    const not_stisla_packed_block_t* blk = &p->blocks[b];
+    const uint64_t r = not_stisla_bits_read(p->bits, blk->offset + (uint64_t)j * blk->width, blk->width);
+    return (int64_t)(blk->base + not_stisla_packed_line(blk, j) + r);
+}
+
+static inline size_t not_stisla_packed_block_len(const not_stisla_packed_t* p, size_t b) {
+    return (b + 1 < p->num_blocks) ? p->block_keys : p->n - b * p->block_keys;
+}
+
+/* Fit the block's line and residual width; returns the width */
+static unsigned not_stisla_packed_fit(not_stisla_packed_block_t* blk, const int64_t* keys, size_t cnt) {
+    const uint64_t span = (uint64_t)keys[cnt - 1] - (uint64_t)keys[0];
+
+    /* Spans past INT64_MAX keep a flat line so residuals fit 64 bits */
+    blk->slope = 0;
+    blk->shift = 0;
+    if (cnt > 1 && span > 0 && span <= (uint64_t)INT64_MAX) {
+        const unsigned shift = (unsigned)__builtin_clzll(span);
+        blk->shift = (uint8_t)(shift < NOT_STISLA_PACKED_MAX_SHIFT ? shift : NOT_STISLA_PACKED_MAX_SHIFT);
+        blk->slope = (span << blk->shift) / (cnt - 1);
+    }
+
+    int64_t min_r = INT64_MAX, max_r = INT64_MIN;
+    for (size_t j = 0; j < cnt; ++j) {
+        const int64_t r = (int64_t)((uint64_t)keys[j] - (uint64_t)keys[0] - not_stisla_packed_line(blk, j));
+        if (r < min_r) min_r = r;
+        if (r > max_r) max_r = r;
+    }
+    blk->base = (uint64_t)keys[0] + (uint64_t)min_r;
+
+    const uint64_t range = (uint64_t)max_r - (uint64_t)min_r;
+    blk->width = (uint8_t)(range ? 64 - __builtin_clzll(range) : 0);
+    return blk->width;
+}
+
+not_stisla_packed_t* not_stisla_packed_build(const int64_t* arr, size_t n, size_t block_keys) {
+    if (!arr || n == 0) return NULL;
+    if (block_keys == 0) block_keys = NOT_STISLA_PACKED_DEFAULT_BLOCK;
+
+    not_stisla_packed_t* p = calloc(1, sizeof(not_stisla_packed_t));
+    if (!p) return NULL;
+    p->n = n;
+    p->block_keys = block_keys;
+    p->num_blocks = (n + block_keys - 1) / block_keys;
+    p->last = arr[n - 1];
+    p->heads = malloc(p->num_blocks * sizeof(int64_t));
+    p->blocks = malloc(p->num_blocks * sizeof(not_stisla_packed_block_t));
+    if (!p->heads || !p->blocks) {
+        not_stisla_packed_destroy(p);
+        return NULL;
+    }
+
+    /* First pass fits every block and sizes the packed array */
+    uint64_t total = 0;
+    for (size_t b = 0; b < p->num_blocks; ++b) {
+        const size_t cnt = not_stisla_packed_block_len(p, b);
+        p->heads[b] = arr[b * block_keys];
+        p->blocks[b].offset = total;
+        total += (uint64_t)not_stisla_packed_fit(&p->blocks[b], arr + b * block_keys, cnt) * cnt;
+    }
+
+    p->bit_words = (size_t)((total + 63) / 64) + 1;
+    p->bits = calloc(p->bit_words, sizeof(uint64_t));
+    if (!p->bits) {
+        not_stisla_packed_destroy(p);
+        return NULL;
+    }
+
+    for (size_t b = 0; b < p->num_blocks; ++b) {
+        const not_stisla_packed_block_t* blk = &p->blocks[b];
+        const int64_t* keys = arr + b * block_keys;
+        const size_t cnt = not_stisla_packed_block_len(p, b);
+        for (size_t j = 0; j < cnt; ++j) {
+            const uint64_t r = (uint64_t)keys[j] - blk->base - not_stisla_packed_line(blk, j);
+            not_stisla_bits_write(p->bits, blk->offset + (uint64_t)j * blk->width, blk->width, r);
+        }
+    }
+    return p;
+}
+
+void not_stisla_packed_destroy(not_stisla_packed_t* packed) {
+    if (packed) {
+        free(packed->heads);
+        free(packed->blocks);
+        free(packed->bits);
+        free(packed);
+    }
+}
+
+size_t not_stisla_packed_length(const not_stisla_packed_t* packed) {
+    return packed ? packed->n : 0;
+}
+
+size_t not_stisla_packed_size_bytes(const not_stisla_packed_t* packed) {
+    if (!packed) return 0;
+    return sizeof(not_stisla_packed_t) +
+           packed->num_blocks * (sizeof(int64_t) + sizeof(not_stisla_packed_block_t)) +
+           packed->bit_words * sizeof(uint64_t);
+}
+
+int64_t not_stisla_packed_get(const not_stisla_packed_t* packed, size_t i) {
+    if (!packed || i >= packed->n) return 0;
+    return not_stisla_packed_key(packed, i / packed->block_keys, i % packed->block_keys);
+}
+
+size_t not_stisla_packed_next_geq(const not_stisla_packed_t* packed, int64_t key, int64_t* value) {
+    if (!packed) return 0;
+    if (key <= packed->heads[0]) {
+        if (value) *value = packed->heads[0];
+        return 0;
+    }
+    if (key > packed->last) return packed->n;
+
+    const size_t b = not_stisla_find_block(packed->heads, packed->n, packed->last, packed->block_keys, key);
+    const size_t cnt = not_stisla_packed_block_len(packed, b);
+    const int64_t end = (b + 1 < packed->num_blocks) ? packed->heads[b + 1] : packed->last;
+
+    /* Key 0 is below key; find the first key >= key in (0, cnt], where
+     * cnt stands for the next block's head */
+    size_t j = (size_t)not_stisla_interpolate(packed->heads[b], end, 0, cnt, key);
+    if (j == 0) j = 1;
+    size_t lo, hi, step = 1;
+    if (j < cnt && not_stisla_packed_key(packed, b, j) < key) {
+        lo = j;
+        while (lo + step < cnt && not_stisla_packed_key(packed, b, lo + step) < key) step <<= 1;
+        hi = (lo + step < cnt) ? lo + step : cnt;
+    } else {
+        hi = j;
+        while (step < hi && not_stisla_packed_key(packed, b, hi - step) >= key) step <<= 1;
+        lo = (step < hi) ? hi - step : 0;
+    }
+    /* key(lo) < key <= key(hi) */
+    while (hi - lo > 1) {
+        const size_t mid = lo + ((hi - lo) >> 1);
+        if (not_stisla_packed_key(packed, b, mid) < key) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+
+    const size_t i = b * packed->block_keys + hi;
+    if (value && i < packed->n) *value = (hi < cnt) ? not_stisla_packed_key(packed, b, hi) : packed->heads[b + 1];
+    return i;
+}
+
+not_stisla_result_t not_stisla_packed_search(const not_stisla_packed_t* packed, int64_t key) {
+    int64_t found;
+    const size_t i = not_stisla_packed_next_geq(packed, key, &found);
+    return (packed && i < packed->n && found == key) ? i : NOT_STISLA_NOT_FOUND;
+}
@@ -0,0 +1,280 @@
+/**
+ * NOT_STISLA Shared - Learned anchor tables in cross-process shared memory
+ *
+ * Many processes searching the same mapped array learn one table together
+ *
+ * Features:
+ * - Offsets only, no pointers: valid at any mapping address
+ * - Constant-time attach
+ * - Anchors published under a sequence lock; readers never take a lock
+ * - Learning by try-lock: a busy or stalled learner is skipped, never waited for
+ * - Robust process-shared learner lock: a learner that died holding it is
+ *   detected by the kernel, whatever its pid or namespace, and its edit repaired
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "not_stisla_internal.h"
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+/* Configuration */
+#define NOT_STISLA_SHARED_MAGIC 0x4E53534841524433ULL  /* "NSSHARD3" */
+#define NOT_STISLA_SHARED_DEFAULT_ANCHORS 256
+#define NOT_STISLA_SHARED_MAX_RETRIES 64  /* Snapshot attempts before searching without the model */
+
+_Static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "shared tables need address-free 64-bit atomics");
+
+typedef struct {
+    _Atomic int64_t v;
+    _Atomic uint64_t i;
+} not_stisla_shared_anchor_t;
+
+/* Region layout: this header, then 'capacity' anchors at anchors_offset */
+struct not_stisla_shared {
+    _Atomic uint64_t magic;     /* Stored last by init */
+    uint64_t bytes;
+    uint64_t capacity;
+    uint64_t anchors_offset;
+    uint64_t n;                 /* Array the table learns over */
+    int64_t first;
+    int64_t last;
+
+    _Alignas(64) _Atomic uint64_t seq;  /* Odd while a learner edits anchors */
+    _Atomic uint64_t count;
+    _Atomic uint64_t learned;
+    _Atomic uint64_t skipped;           /* Lessons dropped because the lock was busy */
+    pthread_mutex_t lock;               /* Learner try-lock: robust and process-shared */
+};
+
+static inline size_t not_stisla_shared_header_bytes(void) {
+    return (sizeof(not_stisla_shared_t) + 63) & ~(size_t)63;
+}
+
+static inline not_stisla_shared_anchor_t* not_stisla_shared_anchors(not_stisla_shared_t* table) {
+    return (not_stisla_shared_anchor_t*)((char*)table + table->anchors_offset);
+}
+
+size_t not_stisla_shared_size(size_t max_anchors) {
+    if (max_anchors == 0) max_anchors = NOT_STISLA_SHARED_DEFAULT_ANCHORS;
+    if (max_anchors < 2) max_anchors = 2;
+    return not_stisla_shared_header_bytes() + max_anchors * sizeof(not_stisla_shared_anchor_t);
+}
+
+not_stisla_shared_t* not_stisla_shared_init(void* mem, size_t len, const int64_t* arr, size_t n) {
+    if (!mem || !arr || n < 2 || ((uintptr_t)mem & 63) != 0) return NULL;
+    if (len < not_stisla_shared_size(2)) return NULL;
+
+    not_stisla_shared_t* table = mem;
+    atomic_store_explicit(&table->magic, 0, memory_order_relaxed);
+    table->bytes = len;
+    table->anchors_offset = not_stisla_shared_header_bytes();
+    table->capacity = (len - table->anchors_offset) / sizeof(not_stisla_shared_anchor_t);
+    table->n = n;
+    table->first = arr[0];
+    table->last = arr[n - 1];
+    atomic_store_explicit(&table->seq, 0, memory_order_relaxed);
+
+    /* The kernel releases a robust lock whose owner dies and tells the next taker */
+    pthread_mutexattr_t attr;
+    if (pthread_mutexattr_init(&attr) != 0) return NULL;
+    const bool attr_ok = pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED) == 0 &&
+                         pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST) == 0 &&
+                         pthread_mutex_init(&table->lock, &attr) == 0;
+    pthread_mutexattr_destroy(&attr);
+    if (!attr_ok) return NULL;
+    atomic_store_explicit(&table->learned, 0, memory_order_relaxed);
+    atomic_store_explicit(&table->skipped, 0, memory_order_relaxed);
+
+    not_stisla_shared_anchor_t* anchors = not_stisla_shared_anchors(table);
+    atomic_store_explicit(&anchors[0].v, arr[0], memory_order_relaxed);
+    atomic_store_explicit(&anchors[0].i, 0, memory_order_relaxed);
+    atomic_store_explicit(&anchors[1].v, arr[n - 1], memory_order_relaxed);
+    atomic_store_explicit(&anchors[1].i, n - 1, memory_order_relaxed);
+    atomic_store_explicit(&table->count, 2, memory_order_relaxed);
+
+    atomic_store_explicit(&table->magic, NOT_STISLA_SHARED_MAGIC, memory_order_release);
+    return table;
+}
+
+not_stisla_shared_t* not_stisla_shared_attach(void* mem, size_t len) {
+    if (!mem || ((uintptr_t)mem & 63) != 0 || len < not_stisla_shared_size(2)) return NULL;
+
+    not_stisla_shared_t* table = mem;
+    if (atomic_load_explicit(&table->magic, memory_order_acquire) != NOT_STISLA_SHARED_MAGIC) return NULL;
+    if (table->bytes > len || table->anchors_offset != not_stisla_shared_header_bytes() || table->capacity < 2 ||
+        table->anchors_offset + table->capacity * sizeof(not_stisla_shared_anchor_t) > table->bytes) {
+        return NULL;
+    }
+    return table;
+}
+
+/* Anchors left by a learner that died mid-edit: keep the ones that still
+ * match the array in order, restore the endpoints, and make seq even again.
+ * The caller holds the lock. */
+static void not_stisla_shared_repair(not_stisla_shared_t* table, const int64_t* arr, size_t n) {
+    not_stisla_shared_anchor_t* anchors = not_stisla_shared_anchors(table);
+    const uint64_t s = atomic_load_explicit(&table->seq, memory_order_relaxed);
+    if (!(s & 1)) return;
+
+    /* An interrupted shift may have written one slot past count */
+    size_t count = atomic_load_explicit(&table->count, memory_order_relaxed);
+    if (count < table->capacity) ++count;
+    if (count > table->capacity) count = table->capacity;
+
+    size_t kept = 0;
+    for (size_t a = 0; a < count; ++a) {
+        const int64_t v = atomic_load_explicit(&anchors[a].v, memory_order_relaxed);
+        const uint64_t i = atomic_load_explicit(&anchors[a].i, memory_order_relaxed);
+        if (i >= n || arr[i] != v) continue;
+        if (kept > 0 && (v <= atomic_load_explicit(&anchors[kept - 1].v, memory_order_relaxed) ||
+                         i <= atomic_load_explicit(&anchors[kept - 1].i, memory_order_relaxed))) {
+            continue;
+        }
+        atomic_store_explicit(&anchors[kept].v, v, memory_order_relaxed);
+        atomic_store_explicit(&anchors[kept].i, i, memory_order_relaxed);
+        ++kept;
+    }
+    if (kept < 2 || atomic_load_explicit(&anchors[0].i, memory_order_relaxed) != 0 ||
+        atomic_load_explicit(&anchors[kept - 1].i, memory_order_relaxed) != n - 1) {
+        atomic_store_explicit(&anchors[0].v, arr[0], memory_order_relaxed);
+        atomic_store_explicit(&anchors[0].i, 0, memory_order_relaxed);
+        atomic_store_explicit(&anchors[1].v, arr[n - 1], memory_order_relaxed);
+        atomic_store_explicit(&anchors[1].i, n - 1, memory_order_relaxed);
+        kept = 2;
+    }
+    atomic_store_explicit(&table->count, kept, memory_order_relaxed);
+    atomic_store_explicit(&table->seq, s + 1, memory_order_release);
+}
+
+/* Take the learner lock without waiting. A lock whose owner died is handed
+ * over by the kernel (EOWNERDEAD); the owner's unfinished edit is repaired. */
+static bool not_stisla_shared_lock(not_stisla_shared_t* table, const int64_t* arr, size_t n) {
+    const int rc = pthread_mutex_trylock(&table->lock);
+    if (rc == EOWNERDEAD) {
+        not_stisla_shared_repair(table, arr, n);
+        pthread_mutex_consistent(&table->lock);
+        return true;
+    }
+    return rc == 0;
+}
+
+/* Insert an anchor if no other process is learning; never waits */
+static void not_stisla_shared_learn(not_stisla_shared_t* table, const int64_t* arr, size_t n, int64_t value,
+                                    size_t index) {
+    if (!not_stisla_shared_lock(table, arr, n)) {
+        atomic_fetch_add_explicit(&table->skipped, 1, memory_order_relaxed);
+        return;
+    }
+
+    /* Only the lock holder writes anchors, so plain reads here are stable */
+    not_stisla_shared_anchor_t* anchors = not_stisla_shared_anchors(table);
+    const size_t count = atomic_load_explicit(&table->count, memory_order_relaxed);
+    size_t pos = 0;
+    while (pos < count && atomic_load_explicit(&anchors[pos].v, memory_order_relaxed) < value) ++pos;
+
+    if (count < table->capacity && pos > 0 && pos < count &&
+        atomic_load_explicit(&anchors[pos].v, memory_order_relaxed) != value) {
+        const uint64_t s = atomic_load_explicit(&table->seq, memory_order_relaxed);
+        atomic_store_explicit(&table->seq, s + 1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+
+        for (size_t a = count; a > pos; --a) {
+            atomic_store_explicit(&anchors[a].v, atomic_load_explicit(&anchors[a - 1].v, memory_order_relaxed),
+                                  memory_order_relaxed);
+            atomic_store_explicit(&anchors[a].i, atomic_load_explicit(&anchors[a - 1].i, memory_order_relaxed),
+                                  memory_order_relaxed);
+        }
+        atomic_store_explicit(&anchors[pos].v, value, memory_order_relaxed);
+        atomic_store_explicit(&anchors[pos].i, index, memory_order_relaxed);
+        atomic_store_explicit(&table->count, count + 1, memory_order_relaxed);
+
+        atomic_store_explicit(&table->seq, s + 2, memory_order_release);
+        atomic_fetch_add_explicit(&table->learned, 1, memory_order_relaxed);
+    }
+
+    pthread_mutex_unlock(&table->lock);
+}
+
+not_stisla_result_t not_stisla_shared_search(not_stisla_shared_t* table, const int64_t* arr, size_t n, int64_t key,
+                                             size_t tol) {
+    if (!arr || n == 0) return NOT_STISLA_NOT_FOUND;
+
+    /* A table learned over another array can only mislead */
+    if (!table || n != table->n || arr[0] != table->first || arr[n - 1] != table->last) {
+        return not_stisla_search(arr, n, key, NULL, tol);
+    }
+    if (key < arr[0] || key > arr[n - 1]) return NOT_STISLA_NOT_FOUND;
+
+    /* Step 1: Consistent copy of the bounding anchors. A learner that died
+     * mid-edit leaves seq odd: after a few tries, take its lock over and
+     * repair the anchors, else search without the model. */
+    const not_stisla_shared_anchor_t* anchors = not_stisla_shared_anchors(table);
+    int64_t l_v = 0, r_v = 0;
+    size_t l_i = 0, r_i = 0;
+    bool snapped = false;
+    for (int attempt = 0; attempt < 2 * NOT_STISLA_SHARED_MAX_RETRIES && !snapped; ++attempt) {
+        if (attempt == NOT_STISLA_SHARED_MAX_RETRIES) {
+            if (!not_stisla_shared_lock(table, arr, n)) break;
+            pthread_mutex_unlock(&table->lock);
+        }
+
+        const uint64_t s1 = atomic_load_explicit(&table->seq, memory_order_acquire);
+        if (s1 & 1) continue;
+
+        size_t count = atomic_load_explicit(&table->count, memory_order_relaxed);
+        if (count > table->capacity) count = table->capacity;
+        if (count < 2) continue;
+
+        size_t lo = 0;
+        size_t hi = count - 1;
+        while (lo + 1 < hi) {
+            const size_t mid = lo + ((hi - lo) >> 1);
+            if (atomic_load_explicit(&anchors[mid].v, memory_order_relaxed) <= key) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+        l_v = atomic_load_explicit(&anchors[lo].v, memory_order_relaxed);
+        l_i = atomic_load_explicit(&anchors[lo].i, memory_order_relaxed);
+        r_v = atomic_load_explicit(&anchors[lo + 1].v, memory_order_relaxed);
+        r_i = atomic_load_explicit(&anchors[lo + 1].i, memory_order_relaxed);
+
+        atomic_thread_fence(memory_order_acquire);
+        snapped = atomic_load_explicit(&table->seq, memory_order_relaxed) == s1;
+    }
+    if (!snapped || l_i >= r_i || r_i >= n) {
+        return not_stisla_search(arr, n, key, NULL, tol);
+    }
+
+    /* Step 2: Interpolate, search the tolerance window, escalate to the segment */
+    const size_t pred = (size_t)not_stisla_interpolate(l_v, r_v, l_i, r_i, key);
+    const size_t lo = (pred < l_i + tol) ? l_i : pred - tol;
+    const size_t hi = (pred + tol > r_i) ? r_i : pred + tol;
+
+    size_t result = not_stisla_local_search(arr, lo, hi, key);
+    if (result == NOT_STISLA_NOT_FOUND) {
+        if (key < arr[lo] && lo > l_i) {
+            result = not_stisla_local_search(arr, l_i, lo - 1, key);
+        } else if (key > arr[hi] && hi < r_i) {
+            result = not_stisla_local_search(arr, hi + 1, r_i, key);
+        }
+    }
+
+    /* Step 3: Teach every attached process about a bad prediction */
+    if (result != NOT_STISLA_NOT_FOUND) {
+        const size_t diff = (pred > result) ? (pred - result) : (result - pred);
+        if (diff > tol && atomic_load_explicit(&table->count, memory_order_relaxed) < table->capacity) {
+            not_stisla_shared_learn(table, arr, n, arr[result], result);
+        }
+    }
+    return result;
+}
+
+void not_stisla_shared_get_stats(not_stisla_shared_t* table, size_t* anchors, size_t* learned, size_t* skipped) {
+    if (anchors) *anchors = table ? atomic_load_explicit(&table->count, memory_order_relaxed) : 0;
+    if (learned) *learned = table ? atomic_load_explicit(&table->learned, memory_order_relaxed) : 0;
+    if (skipped) *skipped = table ? atomic_load_explicit(&table->skipped, memory_order_relaxed) : 0;
+}
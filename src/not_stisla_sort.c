@@ -0,0 +1,261 @@
+/**
+ * NOT_STISLA Sort - Parallel LSD radix sort and sort-then-index ingestion
+ *
+ * Turns unsorted int64 keys into a sorted array plus its spline model
+ *
+ * Features:
+ * - 8-bit digits, stable, signed keys ordered by flipping the sign bit
+ * - Digits shared by every key are skipped
+ * - Optional permutation for reordering payloads
+ * - Ingestion fits the spline on the sorting threads right after the last pass
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "not_stisla_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+/* Configuration */
+#define NOT_STISLA_SORT_DIGITS 8
+#define NOT_STISLA_SORT_RADIX 256
+#define NOT_STISLA_SORT_MIN_CHUNK (1u << 16)  /* Keys per sort thread, at least */
+
+/* Shared state of one sort; each worker owns chunk [n*id/threads, n*(id+1)/threads) */
+typedef struct {
+    int64_t* keys;
+    int64_t* key_tmp;
+    size_t* perm;
+    size_t* perm_tmp;
+    size_t n;
+    size_t threads;
+    size_t (*hist)[NOT_STISLA_SORT_DIGITS][NOT_STISLA_SORT_RADIX];  /* Per thread, all digits */
+    pthread_barrier_t barrier;
+
+    /* Start gate: workers only run once every thread exists */
+    pthread_mutex_t gate_lock;
+    pthread_cond_t gate;
+    int gate_state;  /* 0 = waiting, 1 = run, -1 = abort */
+
+    /* Ingestion: fit the sorted chunk after the last pass */
+    bool fit;
+    size_t max_error;
+    not_stisla_spline_buffer_t* bufs;
+    bool* fit_ok;
+} not_stisla_sort_job_t;
+
+typedef struct {
+    not_stisla_sort_job_t* job;
+    size_t id;
+} not_stisla_sort_worker_t;
+
+static inline unsigned not_stisla_sort_digit(int64_t key, unsigned d) {
+    return (unsigned)((((uint64_t)key ^ (UINT64_C(1) << 63)) >> (d * 8)) & 0xFF);
+}
+
+static void not_stisla_sort_run(not_stisla_sort_job_t* job, size_t id) {
+    const size_t n = job->n;
+    const size_t threads = job->threads;
+    const size_t begin = n / threads * id;
+    const size_t end = (id + 1 == threads) ? n : n / threads * (id + 1);
+    size_t (*hist)[NOT_STISLA_SORT_RADIX] = job->hist[id];
+
+    /* Histogram every digit in one read pass */
+    memset(hist, 0, sizeof(job->hist[0]));
+    for (size_t i = begin; i < end; ++i) {
+        const uint64_t k = (uint64_t)job->keys[i] ^ (UINT64_C(1) << 63);
+        for (unsigned d = 0; d < NOT_STISLA_SORT_DIGITS; ++d) {
+            hist[d][(k >> (d * 8)) & 0xFF]++;
+        }
+    }
+    if (job->perm) {
+        for (size_t i = begin; i < end; ++i) job->perm[i] = i;
+    }
+    pthread_barrier_wait(&job->barrier);
+
+    /* A digit shared by every key is a no-op pass. Decided once from the
+     * global totals, before any worker recounts, so all workers agree. */
+    bool active[NOT_STISLA_SORT_DIGITS];
+    for (unsigned d = 0; d < NOT_STISLA_SORT_DIGITS; ++d) {
+        active[d] = true;
+        for (unsigned b = 0; b < NOT_STISLA_SORT_RADIX && active[d]; ++b) {
+            size_t total = 0;
+            for (size_t t = 0; t < threads; ++t) total += job->hist[t][d][b];
+            active[d] = (total != n);
+        }
+    }
+
+    int64_t* src = job->keys;
+    int64_t* dst = job->key_tmp;
+    size_t* psrc = job->perm;
+    size_t* pdst = job->perm_tmp;
+    bool fresh = true;  /* Chunk still holds the keys the histograms were taken over */
+
+    for (unsigned d = 0; d < NOT_STISLA_SORT_DIGITS; ++d) {
+        if (!active[d]) continue;
+
+        if (!fresh) {
+            /* Recount this digit over the chunk's current contents */
+            memset(hist[d], 0, sizeof(hist[d]));
+            for (size_t i = begin; i < end; ++i) hist[d][not_stisla_sort_digit(src[i], d)]++;
+            pthread_barrier_wait(&job->barrier);
+        }
+
+        /* Output offset of this worker's keys per bucket: all keys in lower
+         * buckets, then this bucket's keys from lower-numbered workers */
+        size_t offsets[NOT_STISLA_SORT_RADIX];
+        size_t base = 0;
+        for (unsigned b = 0; b < NOT_STISLA_SORT_RADIX; ++b) {
+            size_t before = 0;
+            size_t total = 0;
+            for (size_t t = 0; t < threads; ++t) {
+                if (t < id) before += job->hist[t][d][b];
+                total += job->hist[t][d][b];
+            }
+            offsets[b] = base + before;
+            base += total;
+        }
+
+        for (size_t i = begin; i < end; ++i) {
+            const size_t o = offsets[not_stisla_sort_digit(src[i], d)]++;
+            dst[o] = src[i];
+            if (psrc) pdst[o] = psrc[i];
+        }
+        pthread_barrier_wait(&job->barrier);
+
+        int64_t* swap = src;
+        src = dst;
+        dst = swap;
+        size_t* pswap = psrc;
+        psrc = pdst;
+        pdst = pswap;
+        fresh = false;
+    }
+
+    /* Odd pass count leaves the result in the scratch buffers */
+    if (src != job->keys) {
+        memcpy(&job->keys[begin], &src[begin], (end - begin) * sizeof(int64_t));
+        if (psrc) memcpy(&job->perm[begin], &psrc[begin], (end - begin) * sizeof(size_t));
+    }
+
+    if (job->fit) {
+        pthread_barrier_wait(&job->barrier);
+        const size_t fit_begin = not_stisla_spline_chunk_start(job->keys, n, threads, id);
+        const size_t fit_end = not_stisla_spline_chunk_start(job->keys, n, threads, id + 1);
+        job->fit_ok[id] = not_stisla_spline_fit(job->keys, fit_begin, fit_end, job->max_error, &job->bufs[id]);
+    }
+}
+
+static void* not_stisla_sort_worker(void* arg) {
+    not_stisla_sort_worker_t* worker = arg;
+    not_stisla_sort_job_t* job = worker->job;
+
+    pthread_mutex_lock(&job->gate_lock);
+    while (job->gate_state == 0) pthread_cond_wait(&job->gate, &job->gate_lock);
+    const bool run = job->gate_state > 0;
+    pthread_mutex_unlock(&job->gate_lock);
+
+    if (run) not_stisla_sort_run(job, worker->id);
+    return NULL;
+}
+
+static void not_stisla_sort_open_gate(not_stisla_sort_job_t* job, int state) {
+    pthread_mutex_lock(&job->gate_lock);
+    job->gate_state = state;
+    pthread_cond_broadcast(&job->gate);
+    pthread_mutex_unlock(&job->gate_lock);
+}
+
+/* Run a sort job on 'threads' workers, the caller being worker 0. If not every
+ * thread can be started, the started ones are released and the job runs on
+ * the caller alone. */
+static bool not_stisla_sort_execute(not_stisla_sort_job_t* job, size_t threads) {
+    pthread_t* handles = malloc(threads * sizeof(pthread_t));
+    not_stisla_sort_worker_t* workers = malloc(threads * sizeof(not_stisla_sort_worker_t));
+    if (!handles || !workers) {
+        free(handles);
+        free(workers);
+        return false;
+    }
+
+    pthread_mutex_init(&job->gate_lock, NULL);
+    pthread_cond_init(&job->gate, NULL);
+    job->gate_state = 0;
+
+    size_t started = 1;
+    for (size_t t = 1; t < threads; ++t, ++started) {
+        workers[t].job = job;
+        workers[t].id = t;
+        if (pthread_create(&handles[t], NULL, not_stisla_sort_worker, &workers[t]) != 0) break;
+    }
+
+    if (started < threads) {
+        not_stisla_sort_open_gate(job, -1);
+        for (size_t t = 1; t < started; ++t) pthread_join(handles[t], NULL);
+        threads = 1;
+    }
+
+    job->threads = threads;
+    pthread_barrier_init(&job->barrier, NULL, (unsigned)threads);
+    if (threads > 1) not_stisla_sort_open_gate(job, 1);
+    not_stisla_sort_run(job, 0);
+    for (size_t t = 1; t < threads; ++t) pthread_join(handles[t], NULL);
+
+    pthread_barrier_destroy(&job->barrier);
+    pthread_cond_destroy(&job->gate);
+    pthread_mutex_destroy(&job->gate_lock);
+    free(handles);
+    free(workers);
+    return true;
+}
+
+/* Allocate scratch space and sort; optionally fit the spline chunks too */
+static bool not_stisla_sort_job(not_stisla_sort_job_t* job, size_t threads) {
+    const size_t n = job->n;
+    job->key_tmp = malloc(n * sizeof(int64_t));
+    job->perm_tmp = job->perm ? malloc(n * sizeof(size_t)) : NULL;
+    job->hist = malloc(threads * sizeof(job->hist[0]));
+    job->bufs = job->fit ? calloc(threads, sizeof(not_stisla_spline_buffer_t)) : NULL;
+    job->fit_ok = job->fit ? calloc(threads, sizeof(bool)) : NULL;
+
+    bool ok = job->key_tmp && job->hist && (!job->perm || job->perm_tmp) && (!job->fit || (job->bufs && job->fit_ok));
+    if (ok) ok = not_stisla_sort_execute(job, threads);
+
+    free(job->key_tmp);
+    free(job->perm_tmp);
+    free(job->hist);
+    job->key_tmp = NULL;
+    job->perm_tmp = NULL;
+    job->hist = NULL;
+    return ok;
+}
+
+bool not_stisla_radix_sort(int64_t* keys, size_t n, size_t* perm, size_t threads) {
+    if (!keys) return false;
+    if (n == 0) return true;
+
+    not_stisla_sort_job_t job = { .keys = keys, .perm = perm, .n = n };
+    return not_stisla_sort_job(&job, not_stisla_resolve_threads(threads, n, NOT_STISLA_SORT_MIN_CHUNK));
+}
+
+not_stisla_spline_t* not_stisla_ingest(int64_t* keys, size_t n, size_t* perm, size_t max_error, size_t threads) {
+    if (!keys || n == 0) return NULL;
+    if (max_error == 0) max_error = NOT_STISLA_SPLINE_DEFAULT_ERROR;
+
+    not_stisla_sort_job_t job = { .keys = keys, .perm = perm, .n = n, .fit = true, .max_error = max_error };
+    const bool sorted = not_stisla_sort_job(&job, not_stisla_resolve_threads(threads, n, NOT_STISLA_SORT_MIN_CHUNK));
+
+    bool fitted = sorted;
+    for (size_t t = 0; sorted && t < job.threads; ++t) fitted = fitted && job.fit_ok[t];
+
+    not_stisla_spline_t* spline = NULL;
+    if (fitted) {
+        spline = not_stisla_spline_assemble(keys, n, max_error, 0, job.bufs, job.threads);
+    } else if (job.bufs) {
+        for (size_t t = 0; t < job.threads; ++t) free(job.bufs[t].points);
+    }
+    free(job.bufs);
+    free(job.fit_ok);
+    return spline;
+}
@@ -0,0 +1,324 @@
+/**
+ * NOT_STISLA Spline - RadixSpline index for DSMIL
+ *
+ * Single-pass error-bounded spline with a radix table over the top key bits
+ *
+ * Features:
+ * - Greedy spline corridor: every key predicted within max_error
+ * - Radix table jumps straight to the spline segment
+ * - Lookup: radix slot, spline segment, bounded data window
+ * - Parallel build: chunks fitted concurrently and concatenated
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "not_stisla_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+/* Configuration */
+#define NOT_STISLA_SPLINE_DEFAULT_RADIX_BITS 18
+#define NOT_STISLA_SPLINE_MAX_RADIX_BITS 30
+#define NOT_STISLA_SPLINE_LINEAR_SCAN 32  /* Segment candidates scanned linearly */
+
+struct not_stisla_spline {
+    not_stisla_spline_point_t* points;
+    size_t num_points;
+    uint32_t* radix;     /* radix[p] = first knot whose prefix is >= p */
+    size_t radix_slots;  /* (1 << radix_bits) + 1 entries in use */
+    unsigned shift;      /* Prefix = (key - min_key) >> shift */
+    int64_t min_key;
+    int64_t max_key;
+    size_t n;
+    size_t max_error;
+};
+
+static bool not_stisla_spline_push(not_stisla_spline_buffer_t* buf, int64_t x, uint64_t y) {
+    if (buf->size == buf->capacity) {
+        const size_t new_cap = buf->capacity ? buf->capacity * 2 : 64;
+        not_stisla_spline_point_t* points = realloc(buf->points, new_cap * sizeof(not_stisla_spline_point_t));
+        if (!points) return false;
+        buf->points = points;
+        buf->capacity = new_cap;
+    }
+    buf->points[buf->size].x = x;
+    buf->points[buf->size].y = y;
+    buf->size++;
+    return true;
+}
+
+/* Greedy spline corridor over arr[begin, end): appends knots so that linear
+ * interpolation between consecutive knots predicts every key's first
+ * position within max_error. The first and last distinct keys are knots. */
+bool not_stisla_spline_fit(const int64_t* arr, size_t begin, size_t end, size_t max_error,
+                           not_stisla_spline_buffer_t* buf) {
+    if (begin >= end) return true;
+    if (!not_stisla_spline_push(buf, arr[begin], begin)) return false;
+
+    not_stisla_spline_corridor_t corridor;
+    not_stisla_spline_corridor_init(&corridor, arr[begin], begin, max_error);
+
+    for (size_t i = begin + 1; i < end; ++i) {
+        if (arr[i] == corridor.prev_x) continue;  /* Knots track first occurrences */
+        if (not_stisla_spline_corridor_step(&corridor, arr[i], i) &&
+            !not_stisla_spline_push(buf, corridor.knot_x, corridor.knot_y)) {
+            return false;
+        }
+    }
+
+    /* Close with the last distinct key */
+    if (corridor.prev_y != corridor.knot_y) {
+        if (!not_stisla_spline_push(buf, corridor.prev_x, corridor.prev_y)) return false;
+    }
+    return true;
+}
+
+size_t not_stisla_spline_chunk_start(const int64_t* arr, size_t n, size_t chunks, size_t c) {
+    if (c == 0) return 0;
+    if (c >= chunks) return n;
+    size_t start = (n / chunks) * c;
+    while (start < n && arr[start] == arr[start - 1]) ++start;
+    return start;
+}
+
+/* One build thread's share of the array */
+typedef struct {
+    const int64_t* arr;
+    size_t begin;
+    size_t end;
+    size_t max_error;
+    not_stisla_spline_buffer_t buf;
+    bool ok;
+} not_stisla_spline_chunk_t;
+
+static void* not_stisla_spline_chunk_fit(void* arg) {
+    not_stisla_spline_chunk_t* chunk = arg;
+    chunk->ok = not_stisla_spline_fit(chunk->arr, chunk->begin, chunk->end, chunk->max_error, &chunk->buf);
+    return NULL;
+}
+
+/* Build the radix table over finished knots */
+static bool not_stisla_spline_finish(not_stisla_spline_t* spline, unsigned radix_bits) {
+    const uint64_t range = (uint64_t)spline->max_key - (uint64_t)spline->min_key;
+    unsigned key_bits = 0;
+    while (key_bits < 64 && (range >> key_bits) != 0) ++key_bits;
+
+    if (radix_bits > key_bits) radix_bits = key_bits;
+    spline->shift = key_bits - radix_bits;
+    spline->radix_slots = ((size_t)1 << radix_bits) + 1;
+
+    spline->radix = malloc((spline->radix_slots + 1) * sizeof(uint32_t));
+    if (!spline->radix) return false;
+
+    size_t prev_prefix = 0;
+    spline->radix[0] = 0;
+    for (size_t k = 0; k < spline->num_points; ++k) {
+        const size_t prefix = ((uint64_t)spline->points[k].x - (uint64_t)spline->min_key) >> spline->shift;
+        for (size_t p = prev_prefix + 1; p <= prefix; ++p) {
+            spline->radix[p] = (uint32_t)k;
+        }
+        prev_prefix = prefix > prev_prefix ? prefix : prev_prefix;
+    }
+    for (size_t p = prev_prefix + 1; p <= spline->radix_slots; ++p) {
+        spline->radix[p] = (uint32_t)spline->num_points;
+    }
+    return true;
+}
+
+/* Each chunk's last knot and the next chunk's first knot are adjacent
+ * distinct keys: the joining segment has no interior keys, so the global
+ * error bound holds without any stitching. */
+not_stisla_spline_t* not_stisla_spline_assemble(const int64_t* arr, size_t n, size_t max_error, unsigned radix_bits,
+                                                not_stisla_spline_buffer_t* bufs, size_t count) {
+    size_t total = 0;
+    for (size_t c = 0; c < count; ++c) total += bufs[c].size;
+
+    not_stisla_spline_t* spline = calloc(1, sizeof(not_stisla_spline_t));
+    if (spline && total > 0 && total <= UINT32_MAX) {
+        if (count == 1) {
+            spline->points = bufs[0].points;
+            bufs[0].points = NULL;
+        } else if ((spline->points = malloc(total * sizeof(not_stisla_spline_point_t))) != NULL) {
+            for (size_t c = 0; c < count; ++c) {
+                if (bufs[c].size == 0) continue;
+                memcpy(&spline->points[spline->num_points], bufs[c].points,
+                       bufs[c].size * sizeof(not_stisla_spline_point_t));
+                spline->num_points += bufs[c].size;
+            }
+        }
+    }
+    for (size_t c = 0; c < count; ++c) {
+        free(bufs[c].points);
+        bufs[c].points = NULL;
+    }
+    if (!spline || !spline->points) {
+        free(spline);
+        return NULL;
+    }
+
+    spline->num_points = total;
+    spline->min_key = arr[0];
+    spline->max_key = arr[n - 1];
+    spline->n = n;
+    spline->max_error = max_error;
+
+    /* Default: about two radix slots per knot, capped */
+    if (radix_bits > NOT_STISLA_SPLINE_MAX_RADIX_BITS) radix_bits = NOT_STISLA_SPLINE_MAX_RADIX_BITS;
+    if (radix_bits == 0) {
+        radix_bits = 1;
+        while (radix_bits < NOT_STISLA_SPLINE_DEFAULT_RADIX_BITS && ((size_t)1 << radix_bits) < 2 * total) {
+            ++radix_bits;
+        }
+    }
+
+    if (!not_stisla_spline_finish(spline, radix_bits)) {
+        not_stisla_spline_destroy(spline);
+        return NULL;
+    }
+    return spline;
+}
+
+not_stisla_spline_t* not_stisla_spline_build(const int64_t* arr, size_t n, size_t max_error, unsigned radix_bits) {
+    return not_stisla_spline_build_parallel(arr, n, max_error, radix_bits, 1);
+}
+
+not_stisla_spline_t* not_stisla_spline_build_parallel(const int64_t* arr, size_t n, size_t max_error,
+                                                      unsigned radix_bits, size_t threads) {
+    if (!arr || n == 0) return NULL;
+    if (max_error == 0) max_error = NOT_STISLA_SPLINE_DEFAULT_ERROR;
+    threads = not_stisla_resolve_threads(threads, n, NOT_STISLA_SPLINE_MIN_CHUNK);
+
+    not_stisla_spline_chunk_t* chunks = calloc(threads, sizeof(not_stisla_spline_chunk_t));
+    pthread_t* workers = malloc(threads * sizeof(pthread_t));
+    bool* started = calloc(threads, sizeof(bool));
+    not_stisla_spline_buffer_t* bufs = malloc(threads * sizeof(not_stisla_spline_buffer_t));
+    if (!chunks || !workers || !started || !bufs) {
+        free(chunks);
+        free(workers);
+        free(started);
+        free(bufs);
+        return NULL;
+    }
+
+    /* The calling thread fits the last chunk itself */
+    for (size_t c = 0; c < threads; ++c) {
+        chunks[c].arr = arr;
+        chunks[c].begin = not_stisla_spline_chunk_start(arr, n, threads, c);
+        chunks[c].end = not_stisla_spline_chunk_start(arr, n, threads, c + 1);
+        chunks[c].max_error = max_error;
+        if (c + 1 < threads) {
+            started[c] = pthread_create(&workers[c], NULL, not_stisla_spline_chunk_fit, &chunks[c]) == 0;
+        }
+        if (!started[c]) not_stisla_spline_chunk_fit(&chunks[c]);
+    }
+
+    bool ok = true;
+    for (size_t c = 0; c < threads; ++c) {
+        if (started[c]) pthread_join(workers[c], NULL);
+        ok = ok && chunks[c].ok;
+        bufs[c] = chunks[c].buf;
+    }
+
+    not_stisla_spline_t* spline = NULL;
+    if (ok) {
+        spline = not_stisla_spline_assemble(arr, n, max_error, radix_bits, bufs, threads);
+    } else {
+        for (size_t c = 0; c < threads; ++c) free(bufs[c].points);
+    }
+
+    free(chunks);
+    free(workers);
+    free(started);
+    free(bufs);
+    return spline;
+}
+
+void not_stisla_spline_destroy(not_stisla_spline_t* spline) {
+    if (spline) {
+        free(spline->points);
+        free(spline->radix);
+        free(spline);
+    }
+}
+
+/* Predicted position of key's first occurrence; caller guarantees min_key <= key <= max_key */
+static inline size_t not_stisla_spline_predict(const not_stisla_spline_t* spline, int64_t key) {
+    /* Step 1: Radix slot bounds the candidate knots */
+    const size_t prefix = ((uint64_t)key - (uint64_t)spline->min_key) >> spline->shift;
+    size_t begin = spline->radix[prefix];
+    size_t end = spline->radix[prefix + 1];
+    if (end >= spline->num_points) end = spline->num_points - 1;
+
+    /* Step 2: First knot >= key within the slot */
+    const not_stisla_spline_point_t* pts = spline->points;
+    if (end - begin < NOT_STISLA_SPLINE_LINEAR_SCAN) {
+        while (begin < end && pts[begin].x < key) ++begin;
+    } else {
+        while (begin < end) {
+            const size_t mid = begin + ((end - begin) >> 1);
+            if (pts[mid].x < key) {
+                begin = mid + 1;
+            } else {
+                end = mid;
+            }
+        }
+    }
+    if (begin == 0 || pts[begin].x == key) return (size_t)pts[begin].y;
+
+    /* Step 3: Interpolate inside the segment */
+    const not_stisla_spline_point_t* down = &pts[begin - 1];
+    const not_stisla_spline_point_t* up = &pts[begin];
+    const double slope = (double)(up->y - down->y) / (double)((uint64_t)up->x - (uint64_t)down->x);
+    return (size_t)down->y + (size_t)((double)((uint64_t)key - (uint64_t)down->x) * slope + 0.5);
+}
+
+size_t not_stisla_spline_lower_bound(const not_stisla_spline_t* spline, const int64_t* arr, int64_t key) {
+    if (!spline || !arr) return 0;
+    if (key <= spline->min_key) return 0;
+    if (key > spline->max_key) return spline->n;
+
+    const size_t n = spline->n;
+    const size_t pred = not_stisla_spline_predict(spline, key);
+    size_t lo = pred > spline->max_error ? pred - spline->max_error : 0;
+    size_t hi = pred + spline->max_error + 1 < n ? pred + spline->max_error + 1 : n;
+
+    /* Present keys are always inside the window; absent keys after long
+     * duplicate runs may not be, so gallop outwards until bracketed */
+    for (size_t step = spline->max_error + 1; lo > 0 && arr[lo - 1] >= key; step <<= 1) {
+        hi = lo;
+        lo = lo > step ? lo - step : 0;
+    }
+    for (size_t step = spline->max_error + 1; hi < n && arr[hi - 1] < key; step <<= 1) {
+        lo = hi;
+        hi = hi + step < n ? hi + step : n;
+    }
+
+    while (lo < hi) {
+        const size_t mid = lo + ((hi - lo) >> 1);
+        if (arr[mid] < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+not_stisla_result_t not_stisla_spline_search(const not_stisla_spline_t* spline, const int64_t* arr, int64_t key) {
+    if (!spline || !arr || key < spline->min_key || key > spline->max_key) return NOT_STISLA_NOT_FOUND;
+
+    const size_t pos = not_stisla_spline_lower_bound(spline, arr, key);
+    return (pos < spline->n && arr[pos] == key) ? pos : NOT_STISLA_NOT_FOUND;
+}
+
+void not_stisla_spline_get_stats(const not_stisla_spline_t* spline, size_t* points, size_t* memory_used_bytes,
+                                 size_t* max_error) {
+    if (points) *points = spline ? spline->num_points : 0;
+    if (max_error) *max_error = spline ? spline->max_error : 0;
+    if (memory_used_bytes) {
+        *memory_used_bytes = spline ?
+            (sizeof(not_stisla_spline_t) + spline->num_points * sizeof(not_stisla_spline_point_t) +
+             (spline->radix_slots + 1) * sizeof(uint32_t)) : 0;
+    }
+}
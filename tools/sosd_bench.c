@@ -0,0 +1,430 @@
+/**
+ * NOT_STISLA SOSD Bench - Run every search variant on a key dump, emit JSON
+ *
+ * Keys come from a binary file in the SOSD layout (u64 count, then that many
+ * sorted uint64 or uint32 keys) or from a DSMIL generator. Files are mapped,
+ * not read, so uint64 dumps whose keys fit int64 are searched in place.
+ *
+ * Queries come from a SOSD equality-lookup file (u64 count, then 16-byte
+ * records: key, padded to 8 bytes, and its position) or are sampled from the
+ * keys. Answers are checked against binary search, not the stored positions.
+ *
+ * Usage: sosd_bench <keys-file | dsmil:telemetry|ids|offsets|events> [options]
+ *   --uint32            Keys file holds uint32 keys (default: from the name)
+ *   --queries FILE      SOSD equality lookups
+ *   --count N           Queries to sample, or keys to generate (default 1M)
+ *   --miss-ratio R      Share of sampled queries that are absent (default 0)
+ *   --tol T             Tolerance for the anchor searches (default 8)
+ *   --seed S            Sampling and generator seed (default 42)
+ *   --json FILE         Write JSON here instead of stdout
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "../include/not_stisla.h"
+#include "../benchmarks/dsmil_datasets.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define SOSD_DEFAULT_COUNT 1000000
+#define SOSD_DEFAULT_TOL 8
+#define SOSD_SPLINE_ERROR 32
+
+typedef struct {
+    const void* base;
+    size_t length;
+} mapped_file_t;
+
+/* Keys as searched: either the mapping itself or an owned copy */
+typedef struct {
+    const int64_t* keys;
+    size_t n;
+    int64_t* owned;
+    bool flipped;  /* uint64 keys past INT64_MAX, stored with the sign bit flipped */
+    const char* key_type;
+} key_set_t;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static bool map_file(const char* path, mapped_file_t* m) {
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        perror(path);
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(uint64_t)) {
+        fprintf(stderr, "%s: not a SOSD file\n", path);
+        close(fd);
+        return false;
+    }
+    void* p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) {
+        perror(path);
+        return false;
+    }
+    m->base = p;
+    m->length = (size_t)st.st_size;
+    return true;
+}
+
+static void unmap_file(mapped_file_t* m) {
+    if (m->base) munmap((void*)m->base, m->length);
+    m->base = NULL;
+}
+
+/* Header count, checked against the file length */
+static bool sosd_count(const mapped_file_t* m, size_t record, const char* path, size_t* count) {
+    uint64_t c;
+    memcpy(&c, m->base, sizeof(c));
+    if (c == 0 || c > (m->length - sizeof(uint64_t)) / record) {
+        fprintf(stderr, "%s: header says %llu records, file holds %zu\n", path, (unsigned long long)c,
+                (m->length - sizeof(uint64_t)) / record);
+        return false;
+    }
+    *count = (size_t)c;
+    return true;
+}
+
+static bool load_keys(const char* path, bool u32, mapped_file_t* m, key_set_t* ks) {
+    if (!map_file(path, m)) return false;
+    if (!sosd_count(m, u32 ? sizeof(uint32_t) : sizeof(uint64_t), path, &ks->n)) return false;
+    const char* payload = (const char*)m->base + sizeof(uint64_t);
+
+    if (u32) {
+        ks->owned = malloc(ks->n * sizeof(int64_t));
+        if (!ks->owned) return false;
+        const uint32_t* src = (const uint32_t*)(const void*)payload;
+        for (size_t i = 0; i < ks->n; ++i) ks->owned[i] = (int64_t)src[i];
+        ks->keys = ks->owned;
+        ks->key_type = "uint32";
+        return true;
+    }
+
+    const uint64_t* src = (const uint64_t*)(const void*)payload;
+    ks->key_type = "uint64";
+    if (src[ks->n - 1] <= (uint64_t)INT64_MAX) {
+        ks->keys = (const int64_t*)(const void*)src;  /* Sorted, so the last key bounds them all */
+        return true;
+    }
+
+    /* Flipping the sign bit maps uint64 order onto int64 order */
+    ks->owned = malloc(ks->n * sizeof(int64_t));
+    if (!ks->owned) return false;
+    for (size_t i = 0; i < ks->n; ++i) ks->owned[i] = (int64_t)(src[i] ^ (UINT64_C(1) << 63));
+    ks->keys = ks->owned;
+    ks->flipped = true;
+    return true;
+}
+
+static bool generate_keys(const char* spec, size_t count, uint64_t seed, key_set_t* ks) {
+    for (int kind = 0; kind < DSMIL_DATA_COUNT; ++kind) {
+        if (strcmp(spec, dsmil_data_name((dsmil_data_kind_t)kind)) != 0) continue;
+        const dsmil_data_config_t cfg = { .n = count, .seed = seed, .skew = 1.0 };
+        ks->owned = malloc(count * sizeof(int64_t));
+        if (!ks->owned || !dsmil_generate((dsmil_data_kind_t)kind, &cfg, ks->owned)) return false;
+        ks->keys = ks->owned;
+        ks->n = count;
+        ks->key_type = "int64";
+        return true;
+    }
+    fprintf(stderr, "unknown generator '%s' (telemetry, ids, offsets, events)\n", spec);
+    return false;
+}
+
+static bool load_queries(const char* path, const key_set_t* ks, bool u32, int64_t** queries, size_t* count) {
+    mapped_file_t m = { 0 };
+    const size_t record = 2 * sizeof(uint64_t);  /* A uint32 key is padded to 8 bytes */
+    if (!map_file(path, &m) || !sosd_count(&m, record, path, count)) {
+        unmap_file(&m);
+        return false;
+    }
+    *queries = malloc(*count * sizeof(int64_t));
+    if (!*queries) {
+        unmap_file(&m);
+        return false;
+    }
+    const char* rec = (const char*)m.base + sizeof(uint64_t);
+    for (size_t q = 0; q < *count; ++q, rec += record) {
+        uint64_t k = 0;
+        if (u32) {
+            uint32_t k32;
+            memcpy(&k32, rec, sizeof(k32));
+            k = k32;
+        } else {
+            memcpy(&k, rec, sizeof(k));
+        }
+        (*queries)[q] = (int64_t)(ks->flipped ? k ^ (UINT64_C(1) << 63) : k);
+    }
+    unmap_file(&m);
+    return true;
+}
+
+/* One search variant: optional build, then a lookup per query */
+typedef struct {
+    const int64_t* arr;
+    size_t n;
+    size_t tol;
+    not_stisla_anchor_table_t* table;
+    not_stisla_frozen_t* frozen;
+    not_stisla_spline_t* spline;
+    not_stisla_live_t* live;
+} variant_ctx_t;
+
+typedef struct {
+    const char* name;
+    bool (*build)(variant_ctx_t*);
+    not_stisla_result_t (*search)(variant_ctx_t*, int64_t);
+} variant_t;
+
+static not_stisla_result_t search_binary(variant_ctx_t* c, int64_t key) {
+    size_t lo = 0, hi = c->n;
+    while (lo < hi) {
+        const size_t mid = lo + ((hi - lo) >> 1);
+        if (c->arr[mid] < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return (lo < c->n && c->arr[lo] == key) ? lo : NOT_STISLA_NOT_FOUND;
+}
+
+static not_stisla_result_t search_endpoints(variant_ctx_t* c, int64_t key) {
+    return not_stisla_search(c->arr, c->n, key, NULL, c->tol);
+}
+
+static bool build_fresh_table(variant_ctx_t* c) {
+    c->table = not_stisla_anchor_table_create();
+    return c->table != NULL;
+}
+
+static bool build_seeded_table(variant_ctx_t* c) {
+    return build_fresh_table(c) && not_stisla_anchor_table_seed(c->table, c->arr, c->n, 0, c->tol);
+}
+
+static bool build_built_table(variant_ctx_t* c) {
+    return build_fresh_table(c) && not_stisla_anchor_table_build(c->table, c->arr, c->n, 0, c->tol);
+}
+
+static not_stisla_result_t search_table(variant_ctx_t* c, int64_t key) {
+    return not_stisla_search(c->arr, c->n, key, c->table, c->tol);
+}
+
+static bool build_frozen(variant_ctx_t* c) {
+    if (!build_built_table(c)) return false;
+    c->frozen = not_stisla_freeze(c->table, c->arr, c->n);
+    return c->frozen != NULL;
+}
+
+static not_stisla_result_t search_frozen(variant_ctx_t* c, int64_t key) {
+    return not_stisla_frozen_search(c->frozen, c->arr, key);
+}
+
+static bool build_spline(variant_ctx_t* c) {
+    c->spline = not_stisla_spline_build_parallel(c->arr, c->n, SOSD_SPLINE_ERROR, 0, 0);
+    return c->spline != NULL;
+}
+
+static not_stisla_result_t search_spline(variant_ctx_t* c, int64_t key) {
+    return not_stisla_spline_search(c->spline, c->arr, key);
+}
+
+static bool build_live(variant_ctx_t* c) {
+    c->live = not_stisla_live_create(c->arr, c->n, c->tol, 0);
+    return c->live != NULL;
+}
+
+static not_stisla_result_t search_live(variant_ctx_t* c, int64_t key) {
+    return not_stisla_live_search(c->live, key);
+}
+
+static const variant_t variants[] = {
+    { "binary_search", NULL, search_binary },
+    { "not_stisla_endpoints", NULL, search_endpoints },
+    { "not_stisla_learned", build_fresh_table, search_table },
+    { "not_stisla_seeded", build_seeded_table, search_table },
+    { "not_stisla_built", build_built_table, search_table },
+    { "not_stisla_frozen", build_frozen, search_frozen },
+    { "not_stisla_live", build_live, search_live },
+    { "radixspline", build_spline, search_spline },
+};
+
+static void variant_free(variant_ctx_t* c) {
+    not_stisla_frozen_destroy(c->frozen);
+    not_stisla_anchor_table_destroy(c->table);
+    not_stisla_spline_destroy(c->spline);
+    not_stisla_live_destroy(c->live);
+}
+
+static void json_string(FILE* out, const char* s) {
+    fputc('"', out);
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') fputc('\\', out);
+        if ((unsigned char)*s < 0x20) {
+            fprintf(out, "\\u%04x", (unsigned)*s);
+        } else {
+            fputc(*s, out);
+        }
+    }
+    fputc('"', out);
+}
+
+static void usage(const char* argv0) {
+    fprintf(stderr,
+            "usage: %s <keys-file | dsmil:telemetry|ids|offsets|events> [--uint32] [--queries FILE]\n"
+            "       [--count N] [--miss-ratio R] [--tol T] [--seed S] [--json FILE]\n",
+            argv0);
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        usage(argv[0]);
+        return 2;
+    }
+    const char* source = argv[1];
+    const char* query_path = NULL;
+    const char* json_path = NULL;
+    bool u32 = strstr(source, "uint32") != NULL;
+    size_t count = SOSD_DEFAULT_COUNT;
+    double miss_ratio = 0.0;
+    size_t tol = SOSD_DEFAULT_TOL;
+    uint64_t seed = 42;
+
+    for (int a = 2; a < argc; ++a) {
+        const bool has_value = a + 1 < argc;
+        if (strcmp(argv[a], "--uint32") == 0) {
+            u32 = true;
+        } else if (strcmp(argv[a], "--queries") == 0 && has_value) {
+            query_path = argv[++a];
+        } else if (strcmp(argv[a], "--count") == 0 && has_value) {
+            count = strtoull(argv[++a], NULL, 10);
+        } else if (strcmp(argv[a], "--miss-ratio") == 0 && has_value) {
+            miss_ratio = strtod(argv[++a], NULL);
+        } else if (strcmp(argv[a], "--tol") == 0 && has_value) {
+            tol = strtoull(argv[++a], NULL, 10);
+        } else if (strcmp(argv[a], "--seed") == 0 && has_value) {
+            seed = strtoull(argv[++a], NULL, 10);
+        } else if (strcmp(argv[a], "--json") == 0 && has_value) {
+            json_path = argv[++a];
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (count == 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    /* Keys */
+    mapped_file_t keys_map = { 0 };
+    key_set_t ks = { 0 };
+    const uint64_t load_start = now_ns();
+    const bool generated = strncmp(source, "dsmil:", 6) == 0;
+    if (generated ? !generate_keys(source + 6, count, seed, &ks) : !load_keys(source, u32, &keys_map, &ks)) {
+        unmap_file(&keys_map);
+        free(ks.owned);
+        return 1;
+    }
+    const uint64_t load_ns = now_ns() - load_start;
+    if (ks.n < 2) {
+        fprintf(stderr, "%s: need at least 2 keys\n", source);
+        unmap_file(&keys_map);
+        free(ks.owned);
+        return 1;
+    }
+
+    /* Fault the mapping in once so the first variant does not pay for it */
+    const uint64_t touch_start = now_ns();
+    volatile int64_t touched = 0;
+    for (size_t i = 0; i < ks.n; i += 4096 / sizeof(int64_t)) touched += ks.keys[i];
+    const uint64_t touch_ns = now_ns() - touch_start;
+
+    /* Queries */
+    int64_t* queries = NULL;
+    size_t num_queries = count;
+    if (query_path) {
+        if (!load_queries(query_path, &ks, u32, &queries, &num_queries)) {
+            unmap_file(&keys_map);
+            free(ks.owned);
+            return 1;
+        }
+    } else {
+        queries = malloc(num_queries * sizeof(int64_t));
+        if (!queries) return 1;
+        dsmil_sample_queries(ks.keys, ks.n, queries, num_queries, miss_ratio, seed + 1);
+    }
+
+    FILE* out = json_path ? fopen(json_path, "w") : stdout;
+    if (!out) {
+        perror(json_path);
+        return 1;
+    }
+
+    fprintf(out, "{\n  \"dataset\": ");
+    json_string(out, source);
+    fprintf(out, ",\n  \"keys\": %zu,\n  \"key_type\": \"%s\",\n  \"mapped\": %s,\n  \"load_ns\": %llu,\n", ks.n,
+            ks.key_type, (!generated && !ks.owned) ? "true" : "false", (unsigned long long)load_ns);
+    fprintf(out, "  \"touch_ns\": %llu,\n", (unsigned long long)touch_ns);
+    fprintf(out, "  \"queries\": %zu,\n  \"query_source\": ", num_queries);
+    json_string(out, query_path ? query_path : "sampled");
+    fprintf(out, ",\n  \"tolerance\": %zu,\n  \"version\": \"%s\",\n  \"results\": [\n", tol, not_stisla_version());
+
+    /* Binary search answers are the reference for every other variant */
+    size_t expected_found = 0;
+    variant_ctx_t ref = { .arr = ks.keys, .n = ks.n, .tol = tol };
+    for (size_t q = 0; q < num_queries; ++q) expected_found += search_binary(&ref, queries[q]) != NOT_STISLA_NOT_FOUND;
+
+    const size_t num_variants = sizeof(variants) / sizeof(variants[0]);
+    for (size_t v = 0; v < num_variants; ++v) {
+        variant_ctx_t c = { .arr = ks.keys, .n = ks.n, .tol = tol };
+        const uint64_t build_start = now_ns();
+        const bool built = !variants[v].build || variants[v].build(&c);
+        const uint64_t build_ns = now_ns() - build_start;
+
+        size_t found = 0;
+        size_t errors = 0;
+        uint64_t search_ns = 0;
+        if (built) {
+            const uint64_t start = now_ns();
+            for (size_t q = 0; q < num_queries; ++q) {
+                found += variants[v].search(&c, queries[q]) != NOT_STISLA_NOT_FOUND;
+            }
+            search_ns = now_ns() - start;
+
+            /* Untimed check: a hit must name the key, a miss must be a real miss */
+            for (size_t q = 0; q < num_queries; ++q) {
+                const not_stisla_result_t r = variants[v].search(&c, queries[q]);
+                const bool present = search_binary(&ref, queries[q]) != NOT_STISLA_NOT_FOUND;
+                errors += (r == NOT_STISLA_NOT_FOUND) ? present : (r >= ks.n || ks.keys[r] != queries[q]);
+            }
+        }
+
+        fprintf(out, "    {\"variant\": \"%s\", \"built\": %s, \"build_ns\": %llu, \"ns_per_op\": %.2f, "
+                     "\"found\": %zu, \"expected_found\": %zu, \"errors\": %zu}%s\n",
+                variants[v].name, built ? "true" : "false", (unsigned long long)build_ns,
+                built ? (double)search_ns / (double)num_queries : 0.0, found, expected_found, errors,
+                v + 1 < num_variants ? "," : "");
+        fflush(out);
+        variant_free(&c);
+    }
+    fprintf(out, "  ]\n}\n");
+
+    if (out != stdout) fclose(out);
+    free(queries);
+    free(ks.owned);
+    unmap_file(&keys_map);
+    return 0;
+}
@@ -0,0 +1,151 @@
+/**
+ * NOT_STISLA Trace Report - Per-phase latency breakdown of a search trace
+ *
+ * Reads events written by not_stisla_trace_write() from a library built with
+ * TRACE=1 and prints cycle percentiles for each search phase plus the
+ * slowest searches.
+ *
+ * Usage: trace_report <trace-file>
+ */
+
+#include "../include/not_stisla.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TRACE_PHASES 6
+#define TRACE_SLOWEST 5
+
+static const char* const phase_names[TRACE_PHASES] = {
+    "begin", "anchor lookup", "interpolation", "window search", "learning", "bookkeeping"
+};
+
+typedef struct {
+    uint64_t* cycles;
+    size_t count;
+    size_t capacity;
+} sample_list_t;
+
+typedef struct {
+    uint64_t total;
+    int64_t key;
+    uint64_t pred;
+    uint64_t window;
+    uint64_t result;
+} slow_search_t;
+
+static int push_sample(sample_list_t* list, uint64_t cycles) {
+    if (list->count == list->capacity) {
+        const size_t new_cap = list->capacity ? list->capacity * 2 : 1024;
+        uint64_t* grown = realloc(list->cycles, new_cap * sizeof(uint64_t));
+        if (!grown) return 0;
+        list->cycles = grown;
+        list->capacity = new_cap;
+    }
+    list->cycles[list->count++] = cycles;
+    return 1;
+}
+
+static int compare_cycles(const void* a, const void* b) {
+    const uint64_t x = *(const uint64_t*)a;
+    const uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static void print_row(const char* name, sample_list_t* list) {
+    if (list->count == 0) {
+        printf("%-15s %10s\n", name, "-");
+        return;
+    }
+    qsort(list->cycles, list->count, sizeof(uint64_t), compare_cycles);
+    double sum = 0.0;
+    for (size_t i = 0; i < list->count; ++i) sum += (double)list->cycles[i];
+    printf("%-15s %10zu %10.1f %10llu %10llu %10llu\n", name, list->count, sum / (double)list->count,
+           (unsigned long long)list->cycles[list->count / 2],
+           (unsigned long long)list->cycles[(list->count * 99) / 100],
+           (unsigned long long)list->cycles[list->count - 1]);
+}
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s <trace-file>\n", argv[0]);
+        return 2;
+    }
+    FILE* f = fopen(argv[1], "rb");
+    if (!f) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    sample_list_t phases[TRACE_PHASES];
+    sample_list_t totals;
+    memset(phases, 0, sizeof(phases));
+    memset(&totals, 0, sizeof(totals));
+    slow_search_t slowest[TRACE_SLOWEST];
+    memset(slowest, 0, sizeof(slowest));
+
+    /* Each search is BEGIN ... END; events outside one (e.g. live index
+     * searches, which have no BEGIN) are skipped */
+    not_stisla_trace_event_t event;
+    bool in_search = false;
+    uint64_t begin = 0;
+    uint64_t prev = 0;
+    size_t events = 0;
+    while (fread(&event, sizeof(event), 1, f) == 1) {
+        events++;
+        if (event.phase >= TRACE_PHASES) continue;
+
+        if (event.phase == NOT_STISLA_TRACE_BEGIN) {
+            in_search = true;
+            begin = prev = event.cycles;
+            continue;
+        }
+        if (!in_search) continue;
+
+        push_sample(&phases[event.phase], event.cycles - prev);
+        prev = event.cycles;
+
+        if (event.phase == NOT_STISLA_TRACE_END) {
+            const uint64_t total = event.cycles - begin;
+            push_sample(&totals, total);
+            in_search = false;
+
+            /* Keep the slowest searches, slowest first */
+            for (size_t s = 0; s < TRACE_SLOWEST; ++s) {
+                if (total > slowest[s].total) {
+                    memmove(&slowest[s + 1], &slowest[s], (TRACE_SLOWEST - s - 1) * sizeof(slow_search_t));
+                    slowest[s].total = total;
+                    slowest[s].key = event.key;
+                    slowest[s].pred = event.pred;
+                    slowest[s].window = event.window;
+                    slowest[s].result = event.result;
+                    break;
+                }
+            }
+        }
+    }
+    fclose(f);
+
+    printf("%zu events, %zu searches (cycles)\n\n", events, totals.count);
+    printf("%-15s %10s %10s %10s %10s %10s\n", "phase", "count", "mean", "p50", "p99", "max");
+    for (size_t p = NOT_STISLA_TRACE_ANCHOR; p < TRACE_PHASES; ++p) {
+        print_row(phase_names[p], &phases[p]);
+    }
+    print_row("total", &totals);
+
+    printf("\nSlowest searches:\n");
+    for (size_t s = 0; s < TRACE_SLOWEST && slowest[s].total; ++s) {
+        printf("%10llu cycles  key=%lld pred=%llu window=%llu result=", (unsigned long long)slowest[s].total,
+               (long long)slowest[s].key, (unsigned long long)slowest[s].pred,
+               (unsigned long long)slowest[s].window);
+        if (slowest[s].result == (uint64_t)NOT_STISLA_NOT_FOUND) {
+            printf("not found\n");
+        } else {
+            printf("%llu\n", (unsigned long long)slowest[s].result);
+        }
+    }
+
+    for (size_t p = 0; p < TRACE_PHASES; ++p) free(phases[p].cycles);
+    free(totals.cycles);
+    return 0;
+}